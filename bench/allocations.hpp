@@ -0,0 +1,12 @@
+#ifndef BENCH_ALLOCATIONS_HPP_XCMAKE
+#define BENCH_ALLOCATIONS_HPP_XCMAKE
+
+#include <cstddef>
+
+namespace xc::bench
+{
+    // number of heap allocations of the process, operator new is replaced in allocations.cpp
+    [[nodiscard]] std::size_t allocations();
+} // xc::bench
+
+#endif // BENCH_ALLOCATIONS_HPP_XCMAKE
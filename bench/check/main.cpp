@@ -0,0 +1,248 @@
+// correctness checks of the build output parsing
+// usage : xc-check [seed], run from the project directory
+// escape sequence stripping of xc::clean_colors : expected outputs of known sequences, then the vector scan compared with a byte by byte reference
+// on generated inputs and on the logs of bench/data
+// diagnostic counting : only the records of the compiler are counted, not the summary lines of xmake
+
+#include <xc/diagnostic.hpp>
+#include <xc/utility.hpp>
+
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    std::size_t failures = 0;
+
+    std::string printable(std::string_view data)
+    {
+        std::string output;
+        for (char c : data)
+        {
+            if (c == '\033') output += "\\e";
+            else if (c == '\a') output += "\\a";
+            else if (c == '\r') output += "\\r";
+            else if (c == '\n') output += "\\n";
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char hex[5];
+                std::snprintf(hex, sizeof hex, "\\x%02x", static_cast<unsigned char>(c));
+                output += hex;
+            }
+            else output.push_back(c);
+        }
+        return output;
+    }
+
+    void check(std::string_view what, std::string_view input, std::string_view result, std::string_view expected)
+    {
+        if (result == expected) return;
+        ++failures;
+        std::fprintf(stderr, "xc-check: %.*s\n  input    %s\n  result   %s\n  expected %s\n",
+                     static_cast<int>(what.size()), what.data(), printable(input).c_str(), printable(result).c_str(), printable(expected).c_str());
+    }
+
+    // ECMA-48 stripping one byte at a time, independent of find_escape / escape_size
+    std::string reference(std::string_view input)
+    {
+        enum class state
+        {
+            text,
+            escape,
+            escape_intermediate,
+            csi_parameter,
+            csi_intermediate,
+            string,
+            string_escape
+        };
+
+        std::string output;
+        auto current = state::text;
+        for (char c : input)
+        {
+            auto byte = static_cast<unsigned char>(c);
+            switch (current)
+            {
+            case state::text:
+                if (c == '\033') current = state::escape;
+                else output.push_back(c);
+                break;
+            case state::escape:
+                if (c == '[') current = state::csi_parameter;
+                else if (c == ']' || c == 'P' || c == 'X' || c == '^' || c == '_') current = state::string;
+                else if (byte >= 0x20 && byte <= 0x2F) current = state::escape_intermediate;
+                else current = state::text;
+                break;
+            case state::escape_intermediate:
+                if (!(byte >= 0x20 && byte <= 0x2F)) current = state::text;
+                break;
+            case state::csi_parameter:
+                if (byte >= 0x30 && byte <= 0x3F) break;
+                [[fallthrough]];
+            case state::csi_intermediate:
+                if (byte >= 0x20 && byte <= 0x2F)
+                {
+                    current = state::csi_intermediate;
+                    break;
+                }
+                current = state::text;
+                // an unexpected byte ends the sequence and is kept
+                if (!(byte >= 0x40 && byte <= 0x7E))
+                {
+                    if (c == '\033') current = state::escape;
+                    else output.push_back(c);
+                }
+                break;
+            case state::string:
+                if (c == '\a') current = state::text;
+                else if (c == '\033') current = state::string_escape;
+                break;
+            // an ESC not followed by \ is part of the string
+            case state::string_escape:
+                if (c == '\\' || c == '\a') current = state::text;
+                else if (c != '\033') current = state::string;
+                break;
+            }
+        }
+        return output;
+    }
+
+    struct sample
+    {
+        std::string_view what;
+        std::string_view input;
+        std::string_view expected;
+    };
+
+    constexpr std::array samples{
+        sample{ "plain text", "[ 25%]: compiling.release src/main.cpp", "[ 25%]: compiling.release src/main.cpp" },
+        sample{ "sgr colors", "\033[01;32m[ 25%]:\033[0m compiling.release src/main.cpp", "[ 25%]: compiling.release src/main.cpp" },
+        sample{ "erase line then progress", "\033[2K\r\033[1;32m[ 50%]:\033[0m linking.release app", "\r[ 50%]: linking.release app" },
+        sample{ "cursor moves", "\033[1A\033[10Cdone\033[1B", "done" },
+        sample{ "private parameters", "\033[?25lhidden cursor\033[?25h", "hidden cursor" },
+        sample{ "csi with intermediates", "a\033[1 qb\033[0\"pc", "abc" },
+        sample{ "osc ended by bel", "\033]0;xmake build\adone", "done" },
+        sample{ "osc ended by st", "\033]8;;file:///src/main.cpp\033\\src/main.cpp\033]8;;\033\\:3:5", "src/main.cpp:3:5" },
+        sample{ "dcs ended by st", "x\033P1$r0m\033\\y", "xy" },
+        sample{ "charset designation", "\033(Bascii\033)0", "ascii" },
+        sample{ "single final byte", "\0337saved\0338", "saved" },
+        sample{ "truncated csi", "error: build failed\033[1;3", "error: build failed" },
+        sample{ "truncated escape", "error: build failed\033", "error: build failed" },
+        sample{ "truncated osc", "title\033]0;xmake", "title" },
+        sample{ "truncated st", "title\033]0;xmake\033", "title" },
+        sample{ "unterminated csi keeps the next byte", "\033[1\ttab", "\ttab" },
+    };
+
+    // an escape sequence at every offset around the 16 and 32 bytes blocks of the vector scan
+    void check_block_edges()
+    {
+        constexpr std::array<std::string_view, 4> sequences{ "\033[0m", "\033]0;t\a", "\033[1 q", "\033" };
+        const std::string text(80, 'x');
+        for (auto sequence : sequences)
+        {
+            for (std::size_t offset = 0; offset <= 70; ++offset)
+            {
+                auto input = text.substr(0, offset) + std::string{ sequence } + text.substr(offset);
+                // a lone ESC takes the following byte as its final byte
+                auto expected = sequence == "\033" ? text.substr(0, offset) + text.substr(offset + 1) : text;
+                check("sequence at offset " + std::to_string(offset), input, xc::clean_colors(input), expected);
+                if (xc::find_escape(input, 0) != offset) check("find_escape at offset " + std::to_string(offset), input, "not found", "found");
+            }
+        }
+    }
+
+    void check_generated(unsigned seed)
+    {
+        constexpr std::string_view alphabet{ "\033\033\033[]P\\\a;01?m qK \"$x\t\r" };
+        std::mt19937 engine{ seed };
+        std::uniform_int_distribution<std::size_t> pick{ 0, alphabet.size() - 1 };
+        std::uniform_int_distribution<std::size_t> length{ 0, 96 };
+        for (int i = 0; i < 200000 && failures < 10; ++i)
+        {
+            std::string input;
+            for (auto size = length(engine); size > 0; --size) input.push_back(alphabet[pick(engine)]);
+            check("generated input", input, xc::clean_colors(input), reference(input));
+        }
+    }
+
+    std::string read(const std::filesystem::path& path)
+    {
+        std::ifstream ifs{ path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+    }
+
+    void check_logs()
+    {
+        for (const auto& entry : std::filesystem::directory_iterator{ "bench/data" })
+        {
+            if (entry.path().extension() != ".log") continue;
+            auto log = read(entry.path());
+            check(entry.path().string(), "<log>", xc::clean_colors(log), reference(log));
+
+            // the same output rendered with TERM=dumb, where every capability is empty
+            auto expected = std::filesystem::path{ entry.path() }.replace_extension(".expected");
+            std::error_code ec;
+            if (std::filesystem::exists(expected, ec))
+                check(expected.string(), "<log>", xc::clean_colors(log), read(expected));
+        }
+    }
+
+    // errors and warnings counted by the build
+    std::string count_diagnostics(std::string_view log)
+    {
+        int errors = 0;
+        int warnings = 0;
+        for (auto line : std::views::split(log, '\n'))
+        {
+            auto message = xc::clean_colors(std::string_view{ line.begin(), line.end() });
+            auto diagnostic = xc::parse_diagnostic(message);
+            if (!diagnostic || !xc::is_compiler_record(*diagnostic)) continue;
+            if (diagnostic->severity >= xc::severity::error) ++errors;
+            else if (diagnostic->severity == xc::severity::warning) ++warnings;
+        }
+        return "errors " + std::to_string(errors) + " warnings " + std::to_string(warnings);
+    }
+
+    void check_counts()
+    {
+        constexpr std::string_view failed_build{ "\033[01;38;5;34m[ 50%]:\033[0m \033[38;5;250mcompiling.release\033[0m src/a.cpp\n"
+                                                 "src/a.cpp: In function 'int main()':\n"
+                                                 "src/a.cpp:3:5: error: 'x' was not declared in this scope\n"
+                                                 "src/a.cpp:4:9: warning: unused variable 'y' [-Wunused-variable]\n"
+                                                 "src/a.hpp:2:7: note: declared here\n"
+                                                 "C:\\project\\src\\b.cpp(12,5): error C2065: 'z': undeclared identifier\n"
+                                                 "LINK : fatal error LNK1104: cannot open file 'app.exe'\n"
+                                                 "warning: ./xmake.lua: unknown option\n"
+                                                 "\033[01;31merror: \033[0mbuild failed" };
+        check("counts of a failed build", failed_build, count_diagnostics(failed_build), "errors 3 warnings 1");
+
+        std::error_code ec;
+        if (!std::filesystem::exists("bench/data/gcc-build.log", ec)) return;
+        auto log = read("bench/data/gcc-build.log");
+        check("counts of bench/data/gcc-build.log", "<log>", count_diagnostics(log), "errors 5 warnings 3");
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    for (const auto& sample : samples)
+    {
+        check(sample.what, sample.input, xc::clean_colors(sample.input), sample.expected);
+        check(std::string{ sample.what } + " (reference)", sample.input, reference(sample.input), sample.expected);
+    }
+    check_block_edges();
+    check_counts();
+    check_generated(argc > 1 ? static_cast<unsigned>(std::stoul(argv[1])) : std::random_device{}());
+    std::error_code ec;
+    if (std::filesystem::exists("bench/data", ec)) check_logs();
+
+    if (failures) std::fprintf(stderr, "xc-check: %zu failures\n", failures);
+    else std::printf("xc-check: ok\n");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,40 @@
+#!/bin/sh
+# diagnostics of gcc 12 on the sources of a sample project, in build order
+# ./gcc-build.sh <project> > gcc-build.log
+cd "${1:-.}"
+export LC_ALL=C.UTF-8
+for f in \
+    src/core/allocator.cpp \
+    src/core/config.cpp \
+    src/core/logger.cpp \
+    src/core/string_pool.cpp \
+    src/net/socket.cpp \
+    src/net/resolver.cpp \
+    src/net/connection.cpp \
+    src/net/http_client.cpp \
+    src/net/tls.cpp \
+    src/io/file_system.cpp \
+    src/io/path.cpp \
+    src/io/reader.cpp \
+    src/io/archive.cpp \
+    src/audio/mixer.cpp \
+    src/audio/decoder.cpp \
+    src/audio/device.cpp \
+    src/ui/widget.cpp \
+    src/ui/layout.cpp \
+    src/ui/theme.cpp \
+    src/ui/stream.cpp \
+    src/render/pipeline.cpp \
+    src/render/shader.cpp \
+    src/render/texture.cpp \
+    src/render/mesh.cpp \
+    src/db/database.cpp \
+    src/db/schema.cpp \
+    src/db/migration.cpp \
+    src/db/statement.cpp \
+    src/script/lexer.cpp \
+    src/script/bytecode.cpp \
+    src/script/interpreter.cpp \
+    src/script/printer.cpp; do
+    g++ -std=c++20 -Wall -Wextra -fdiagnostics-color=always -Iinclude -Isrc -c "$f" -o /dev/null 2>&1
+done
@@ -0,0 +1,29 @@
+#!/bin/sh
+# progress redraws of an xmake-style build, written through the terminal capabilities of tput
+# TERM=xterm-256color script -q -c "stty -onlcr; ./terminal-redraw.sh <project>" /dev/null > terminal-redraw.log
+# TERM=dumb ./terminal-redraw.sh <project> 2>/dev/null > terminal-redraw.expected
+cd "${1:-.}"
+files=$(find src -name '*.cpp' | sort | head -12)
+total=$(echo "$files" | wc -l)
+title() { [ "$TERM" = dumb ] || printf '%s%s%s' "$(tput tsl -T xterm+sl)" "$1" "$(tput fsl -T xterm+sl)"; }
+tput civis
+title "xmake build"
+n=0
+for f in $files; do
+    n=$((n + 1))
+    pct=$((n * 100 / total))
+    tput sc
+    printf '%s[%3d%%]:%s compiling.release %s' "$(tput setaf 2)" "$pct" "$(tput sgr0)" "$f"
+    tput el
+    tput rc
+    tput cr
+    printf '%s' "$(tput el1)"
+done
+tput cr; tput el
+printf '%s[100%%]:%s %sbuild ok!%s\n' "$(tput setaf 2)" "$(tput sgr0)" "$(tput bold)" "$(tput sgr0)"
+printf 'warnings:\n'
+printf '  %s\n' "$(tput setaf 3)src/ui/theme.cpp:14:9: warning: unused variable 'x'$(tput sgr0)"
+tput cuu1; tput cuu 1; tput cud1
+printf 'done\n'
+title "xc"
+tput cnorm
@@ -0,0 +1,161 @@
+// randomized test of xc::parse_command
+// usage : xc-fuzz [iterations] [seed]
+// arbitrary command lines must not crash and every view of the command must point into the arguments
+// the command lines of CLion (generation and build) must be parsed without any allocation
+
+#include "../allocations.hpp"
+
+#include <xc/command.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    using arguments = std::vector<std::string>;
+
+    std::mt19937_64 engine;
+
+    std::size_t uniform(std::size_t count) { return std::uniform_int_distribution<std::size_t>{ 0, count - 1 }(engine); }
+
+    [[noreturn]] void fail(const char* what, const arguments& args)
+    {
+        std::fprintf(stderr, "xc-fuzz: %s, arguments :", what);
+        for (const auto& arg : args) std::fprintf(stderr, " [%s]", arg.c_str());
+        std::fprintf(stderr, "\n");
+        std::exit(1);
+    }
+
+    // spellings of the flags stored as option names, the only views which may not point into the arguments
+    constexpr std::array<std::string_view, 10> option_spellings{ "-A", "-T", "-U", "-C", "-P", "--preset", "--toolchain", "--install-prefix", "--severity", "--file" };
+
+    bool in_arguments(std::string_view view, const arguments& args)
+    {
+        if (view.empty()) return true;
+        for (const auto& arg : args)
+        {
+            if (view.data() >= arg.data() && view.data() + view.size() <= arg.data() + arg.size()) return true;
+        }
+        return false;
+    }
+
+    void check_views(const xc::command& command, const arguments& args)
+    {
+        for (auto view : { command.source_directory, command.build_directory, command.generator, command.build_type, command.positional })
+        {
+            if (!in_arguments(view, args)) fail("view out of the arguments", args);
+        }
+        for (auto target : command.targets)
+        {
+            if (!in_arguments(target, args)) fail("target out of the arguments", args);
+        }
+        for (const auto& entry : command.entries)
+        {
+            if (!in_arguments(entry.name, args) || !in_arguments(entry.type, args) || !in_arguments(entry.value, args)) fail("entry out of the arguments", args);
+        }
+        for (const auto& option : command.options)
+        {
+            bool spelling = false;
+            for (auto item : option_spellings) spelling = spelling || option.name == item;
+            if ((!spelling && !in_arguments(option.name, args)) || !in_arguments(option.value, args)) fail("option out of the arguments", args);
+        }
+    }
+
+    // flags, flag prefixes and values mixed by the random command lines
+    constexpr std::array<std::string_view, 42> tokens{
+        "-S", "-B", "-G", "-D", "-A", "-T", "-U", "-C", "-P", "--preset", "--toolchain", "--install-prefix", "--build", "--target", "-t",
+        "--parallel", "-j", "--config", "--clean-first", "--verbose", "-v", "--version", "--last-errors", "--severity", "--file", "--",
+        "-DCMAKE_BUILD_TYPE=Debug", "-DCMAKE_TRY_COMPILE_TARGET_TYPE:STRING=STATIC_LIBRARY", "-DXC_WATCH=ON", "-D=x", "-Dx", "-j8",
+        "--parallel=4", "--target=app", "-", "--x=", "=", "8", "all", "clean", "build/debug", "CodeBlocks - Unix Makefiles"
+    };
+
+    std::string random_argument()
+    {
+        std::string arg;
+        switch (uniform(4))
+        {
+        case 0: arg = tokens[uniform(tokens.size())]; break;
+        case 1:
+            arg = tokens[uniform(tokens.size())];
+            arg += tokens[uniform(tokens.size())];
+            break;
+        case 2:
+            // prefix of a token
+            arg = tokens[uniform(tokens.size())];
+            arg.resize(uniform(arg.size() + 1));
+            break;
+        default:
+            for (auto size = uniform(12); size > 0; --size) arg.push_back(static_cast<char>(uniform(256)));
+            break;
+        }
+        return arg;
+    }
+
+    // cmake -G <generator> -S <source> -B <build> -D... as run by CLion on a reload
+    arguments generate_shape()
+    {
+        constexpr std::array<std::string_view, 3> build_types{ "Debug", "Release", "RelWithDebInfo" };
+        arguments args{ "-DCMAKE_BUILD_TYPE=" + std::string{ build_types[uniform(build_types.size())] } };
+        args.emplace_back("-DCMAKE_MAKE_PROGRAM=/usr/bin/make");
+        for (auto count = uniform(10); count > 0; --count) args.emplace_back("-DCMAKE_VAR" + std::to_string(count) + ":STRING=" + random_argument());
+        args.insert(args.end(), { "-G", "CodeBlocks - Unix Makefiles", "-S", "/home/user/project", "-B", "/home/user/project/cmake-build-debug" });
+        return args;
+    }
+
+    // cmake --build <build> --target <targets> -j <n>
+    arguments build_shape()
+    {
+        arguments args{ "--build", "/home/user/project/cmake-build-debug", "--target" };
+        for (auto count = uniform(4) + 1; count > 0; --count) args.emplace_back("target" + std::to_string(count));
+        args.insert(args.end(), { "-j", std::to_string(uniform(64) + 1) });
+        return args;
+    }
+
+    xc::command parse(const arguments& args, bool allocation_free)
+    {
+        auto before = xc::bench::allocations();
+        auto command = xc::parse_command(args);
+        if (allocation_free && xc::bench::allocations() != before) fail("allocation while parsing", args);
+        return command;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    engine.seed(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::random_device{}());
+
+    std::size_t rejected = 0;
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+        arguments args;
+        for (auto count = uniform(9); count > 0; --count) args.emplace_back(random_argument());
+        try
+        {
+            check_views(parse(args, false), args);
+        }
+        catch (const std::logic_error&)
+        {
+            // invalid cache entry or missing flag value
+            ++rejected;
+        }
+
+        auto generate = generate_shape();
+        auto command = parse(generate, true);
+        check_views(command, generate);
+        if (command.mode != xc::command_mode::generate) fail("generation not detected", generate);
+
+        auto build = build_shape();
+        command = parse(build, true);
+        check_views(command, build);
+        if (command.mode != xc::command_mode::build || command.targets.size() != build.size() - 5) fail("build not detected", build);
+    }
+    std::printf("xc-fuzz: %zu command lines, %zu rejected\n", iterations, rejected);
+    return 0;
+}
@@ -0,0 +1,249 @@
+// xc benchmarks : wrapper overhead and output throughput
+// usage : xc-bench [output.json], run from the project directory
+// the end-to-end benchmarks use xc-stub, located next to xc-bench, as xmake and cmake
+
+#include "allocations.hpp"
+
+#include <xc/command.hpp>
+#include <xc/diagnostic.hpp>
+#include <xc/launcher.hpp>
+#include <xc/utility.hpp>
+#include <xc/xcmake.hpp>
+
+#include <fmt/core.h>
+#include <process.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    struct result
+    {
+        std::string name;
+        std::size_t iterations{ 0 };
+        double ns_per_op{ 0 };
+        double mb_per_s{ 0 };
+        double allocations_per_op{ 0 };
+    };
+
+    std::vector<result> results;
+    // results are accumulated so that the measured code is not optimized away
+    volatile std::size_t sink = 0;
+
+    // run f until the measure lasts long enough, bytes is the input size of one iteration
+    void measure(const std::string& name, std::size_t bytes, const std::function<void()>& f, std::chrono::milliseconds min_time = std::chrono::milliseconds{ 300 })
+    {
+        using clock = std::chrono::steady_clock;
+        f(); // warm up
+
+        std::size_t iterations = 1;
+        while (true)
+        {
+            auto start_allocations = xc::bench::allocations();
+            auto start = clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) f();
+            auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+            if (elapsed >= std::chrono::duration<double, std::nano>(min_time).count() || iterations >= (1u << 30))
+            {
+                result r{ name, iterations, elapsed / static_cast<double>(iterations), 0, 0 };
+                if (bytes) r.mb_per_s = static_cast<double>(bytes) * static_cast<double>(iterations) / (elapsed / 1e9) / (1024 * 1024);
+                r.allocations_per_op = static_cast<double>(xc::bench::allocations() - start_allocations) / static_cast<double>(iterations);
+                std::fprintf(stderr, "%-32s %12.0f ns/op %10.1f MiB/s %10.1f alloc/op %10zu it\n", r.name.c_str(), r.ns_per_op, r.mb_per_s, r.allocations_per_op, r.iterations);
+                results.push_back(std::move(r));
+                return;
+            }
+            iterations *= 2;
+        }
+    }
+
+    void set_env(const char* name, const std::string& value)
+    {
+#if defined(_WIN32)
+        _putenv_s(name, value.c_str());
+#else
+        setenv(name, value.c_str(), 1);
+#endif
+    }
+
+    std::vector<std::string> read_lines(const fs::path& path)
+    {
+        std::ifstream ifs{ path, std::ios::binary };
+        if (!ifs) throw std::runtime_error{ "missing benchmark data " + path.string() };
+        std::vector<std::string> lines;
+        std::string line;
+        while (std::getline(ifs, line)) lines.emplace_back(std::move(line));
+        return lines;
+    }
+
+    void process(std::vector<std::string> args)
+    {
+        xc::xcmake xcmake{ "xc", std::move(args) };
+        xcmake.process();
+        xc::console::instance().flush();
+    }
+
+    void micro_benchmarks(const fs::path& data)
+    {
+        auto lines = read_lines(data / "gcc-build.log");
+        std::size_t bytes = 0;
+        for (const auto& line : lines) bytes += line.size() + 1;
+
+        std::vector<std::string> clean_lines;
+        for (const auto& line : lines) clean_lines.emplace_back(xc::clean_colors(line));
+
+        std::vector<std::string> clion_args{ "-DCMAKE_BUILD_TYPE=Debug",
+                                             "-DCMAKE_MAKE_PROGRAM=/usr/bin/make",
+                                             "-DCMAKE_C_COMPILER=/usr/bin/cc",
+                                             "-DCMAKE_CXX_COMPILER=/usr/bin/c++",
+                                             "-G",
+                                             "CodeBlocks - Unix Makefiles",
+                                             "-S",
+                                             "/home/user/project",
+                                             "-B",
+                                             "/home/user/project/cmake-build-debug" };
+
+        std::vector<std::string> build_args{ "--build", "/home/user/project/cmake-build-debug", "--target", "app", "tests", "-j", "8" };
+        measure("parse_command.generate", 0, [&] { sink = sink + xc::parse_command(clion_args).entries.size(); });
+        measure("parse_command.build", 0, [&] { sink = sink + xc::parse_command(build_args).targets.size(); });
+        measure("clean_colors.gcc", bytes, [&] {
+            for (const auto& line : lines) sink = sink + xc::clean_colors(line).size();
+        });
+        measure("str_replace.gcc", bytes, [&] {
+            for (auto line : clean_lines) xc::str_replace(line, ": error", " error");
+        });
+        measure("parse_diagnostic.gcc", bytes, [&] {
+            for (const auto& line : clean_lines) sink = sink + xc::parse_diagnostic(line).has_value();
+        });
+        measure("count_diagnostics.gcc", bytes, [&] {
+            int errors = 0;
+            int warnings = 0;
+            for (const auto& line : lines)
+            {
+                auto message = xc::clean_colors(line);
+                auto diagnostic = xc::parse_diagnostic(message);
+                if (!diagnostic || !xc::is_compiler_record(*diagnostic)) continue;
+                if (diagnostic->severity >= xc::severity::error) ++errors;
+                else if (diagnostic->severity == xc::severity::warning) ++warnings;
+            }
+            sink = sink + errors + warnings;
+        });
+
+        xc::xcmake xcmake{ "xc", {} };
+        measure("log_xmake.gcc", bytes, [&] {
+            for (const auto& line : lines) xcmake.log_xmake(line);
+            xc::console::instance().flush();
+        });
+    }
+
+    void end_to_end_benchmarks(const fs::path& data, const fs::path& stub)
+    {
+        auto root = fs::temp_directory_path() / fmt::format("xc-bench-{}", std::chrono::steady_clock::now().time_since_epoch().count());
+        auto bin = root / "bin";
+        auto project = root / "project";
+        fs::create_directories(bin);
+        fs::create_directories(project);
+        for (const auto* tool : { "xmake", "cmake" }) fs::copy_file(stub, bin / (tool + stub.extension().string()));
+        std::ofstream{ project / "xmake.lua" } << "target(\"app\")\n    add_files(\"src/**.cpp\")\n";
+
+#if defined(_WIN32)
+        constexpr char separator = ';';
+#else
+        constexpr char separator = ':';
+#endif
+        const char* path = std::getenv("PATH");
+        set_env("PATH", bin.string() + separator + (path ? path : ""));
+        set_env("XC_STUB_DATA", fs::absolute(data).string());
+        set_env("XC_CACHE_DIR", (root / "cache").string());
+
+        auto previous_path = fs::current_path();
+        fs::current_path(project);
+
+        auto build = (project / "build" / "release").string();
+        std::vector<std::string> generate_args{ "-DCMAKE_BUILD_TYPE=Release", "-G", "Unix Makefiles", "-S", project.string(), "-B", build };
+        auto regenerate_args = generate_args;
+        regenerate_args.emplace_back("-DXC_REGENERATE=ON");
+
+        measure("process.version", 0, [] { process({ "--version" }); });
+        measure("generate.cold", 0, [&] { process(regenerate_args); });
+        measure("generate.cached", 0, [&] { process(generate_args); });
+
+        std::size_t log_bytes = fs::file_size(data / "gcc-build.log");
+        measure("build.replay_gcc", log_bytes, [&] { process({ "--build", build, "--target", "app" }); });
+
+        // process launchers : spawn latency, then output throughput of the gcc-build.log replay
+        // the TinyProcessLib figures are only meaningful with the tiny-process-library package of xmake.lua
+        auto xmake = (bin / ("xmake" + stub.extension().string())).string();
+        auto discard = [](const char*, std::size_t n) { sink = sink + n; };
+        auto tiny_process = [&](const std::vector<std::string>& args) {
+            TinyProcessLib::Process process{ args, "", discard, discard };
+            sink = sink + process.get_exit_status();
+        };
+        measure("spawn.tiny_process", 0, [&] { tiny_process({ xmake, "--version" }); });
+        measure("drain_gcc.tiny_process", log_bytes, [&] { tiny_process({ xmake, "build" }); });
+#if defined(__linux__)
+        auto native = [&](const std::vector<std::string>& args) { sink = sink + xc::launch(args, ".", {}, [](std::int64_t) {}, discard, discard); };
+        measure("spawn.native", 0, [&] { native({ xmake, "--version" }); });
+        measure("drain_gcc.native", log_bytes, [&] { native({ xmake, "build" }); });
+#endif
+        set_env("XC_STUB_LINES_PER_MS", "20");
+        measure("build.replay_gcc.rate_limited", log_bytes, [&] { process({ "--build", build, "--target", "app" }); });
+
+        fs::current_path(previous_path);
+        std::error_code ec;
+        fs::remove_all(root, ec);
+    }
+
+    void write_results(const fs::path& path)
+    {
+        std::ofstream ofs{ path, std::ios::trunc };
+        ofs << "{\n  \"results\": [";
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& r = results[i];
+            ofs << (i ? "," : "") << "\n    "
+                << fmt::format(R"({{"name":"{}","iterations":{},"ns_per_op":{:.1f},"mb_per_s":{:.2f},"allocations_per_op":{:.2f}}})",
+                               xc::json_escape(r.name), r.iterations, r.ns_per_op, r.mb_per_s, r.allocations_per_op);
+        }
+        ofs << "\n  ]\n}\n";
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    fs::path output = argc > 1 ? argv[1] : "xc-bench.json";
+    auto data = fs::absolute("bench/data");
+    fs::path stub = fs::absolute(argv[0]).parent_path() / ("xc-stub" + fs::path{ argv[0] }.extension().string());
+
+    // console output of xc is not part of the measure
+#if defined(_WIN32)
+    std::freopen("NUL", "w", stdout);
+#else
+    std::freopen("/dev/null", "w", stdout);
+#endif
+
+    try
+    {
+        micro_benchmarks(data);
+        if (fs::exists(stub)) end_to_end_benchmarks(data, stub);
+        else std::fprintf(stderr, "%s not found, end-to-end benchmarks skipped\n", stub.string().c_str());
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "xc-bench exception: %s\n", e.what());
+        return 1;
+    }
+
+    write_results(output);
+    std::fprintf(stderr, "results written to %s\n", output.string().c_str());
+    return 0;
+}
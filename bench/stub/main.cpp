@@ -0,0 +1,102 @@
+// stand-in for xmake and cmake used by the end-to-end benchmarks
+// the tool is selected by the executable name, recorded output is replayed from XC_STUB_DATA
+// build replays the gcc diagnostics of gcc-build.log, config prints nothing
+// XC_STUB_LINES_PER_MS limits the replay rate, 0 or unset replays as fast as possible
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::string unquote(std::string arg)
+    {
+        if (arg.size() >= 2 && arg.front() == '"' && arg.back() == '"') return arg.substr(1, arg.size() - 2);
+        return arg;
+    }
+
+    void replay(const std::string& name)
+    {
+        const char* data = std::getenv("XC_STUB_DATA");
+        std::ifstream ifs{ std::filesystem::path{ data ? data : "." } / name, std::ios::binary };
+
+        const char* rate_value = std::getenv("XC_STUB_LINES_PER_MS");
+        auto rate = rate_value ? std::strtol(rate_value, nullptr, 10) : 0;
+
+        std::string line;
+        long lines = 0;
+        while (std::getline(ifs, line))
+        {
+            line += '\n';
+            std::fwrite(line.data(), 1, line.size(), stdout);
+            if (rate > 0 && ++lines % rate == 0)
+            {
+                std::fflush(stdout);
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+            }
+        }
+        std::fflush(stdout);
+    }
+
+    void touch(const std::filesystem::path& path, const std::string& content)
+    {
+        std::error_code ec;
+        if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+        std::ofstream{ path, std::ios::trunc } << content;
+    }
+
+    int xmake(const std::vector<std::string>& args)
+    {
+        if (args.empty()) return 0;
+        if (args[0] == "--version") std::puts("xmake v2.9.1+HEAD.0, A cross-platform build utility based on Lua");
+        else if (args[0] == "config" || args[0] == "f")
+        {
+            for (const auto& arg : args)
+            {
+                if (arg.starts_with("--export=")) touch(arg.substr(9), "mode = \"release\"\nplat = \"linux\"\n");
+            }
+        }
+        else if (args[0] == "project")
+        {
+            touch("CMakeLists.txt", "# this is the build file for project\ncmake_minimum_required(VERSION 3.15.0)\nproject(app)\n");
+            std::puts("create ok!");
+        }
+        else if (args[0] == "build") replay("gcc-build.log");
+        return 0;
+    }
+
+    int cmake(const std::vector<std::string>& args)
+    {
+        if (!args.empty() && args[0] == "--version")
+        {
+            std::puts("cmake version 3.27.4\n\nCMake suite maintained and supported by Kitware (kitware.com/cmake).");
+            return 0;
+        }
+
+        std::string build_directory = ".";
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            if (args[i] == "-B" && i + 1 < args.size()) build_directory = args[i + 1];
+            else if (args[i].starts_with("-B") && args[i].size() > 2) build_directory = args[i].substr(2);
+        }
+        touch(std::filesystem::path{ build_directory } / "CMakeCache.txt", "CMAKE_BUILD_TYPE:STRING=Release\n");
+        std::filesystem::create_directories(std::filesystem::path{ build_directory } / ".cmake" / "api" / "v1" / "reply");
+        replay("cmake-configure.log");
+        return 0;
+    }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) args.emplace_back(unquote(argv[i]));
+
+    auto name = std::filesystem::path{ argv[0] }.stem().string();
+    if (name == "cmake") return cmake(args);
+    return xmake(args);
+}
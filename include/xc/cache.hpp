@@ -0,0 +1,67 @@
+#ifndef INCLUDE_XC_CACHE_HPP_XCMAKE
+#define INCLUDE_XC_CACHE_HPP_XCMAKE
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xc
+{
+    // incremental FNV-1a 64 hash
+    class fingerprint
+    {
+    public:
+        fingerprint& add(std::string_view data);
+        fingerprint& add_file(const std::filesystem::path& path);
+
+        [[nodiscard]] std::uint64_t value() const { return value_; }
+        [[nodiscard]] std::string str() const;
+
+    private:
+        std::uint64_t value_{ 14695981039346656037ull };
+    };
+
+    [[nodiscard]] std::string file_fingerprint(const std::filesystem::path& path);
+    // hash of every .lua file under root, skipping hidden directories and the excluded one
+    [[nodiscard]] std::string lua_fingerprint(const std::filesystem::path& root, const std::filesystem::path& exclude = {});
+
+    // hash of the configurations shared by the builds of a project, <root>/.xmake/<plat>/<arch>/xmake.conf
+    [[nodiscard]] std::string xmake_state_fingerprint(const std::filesystem::path& root);
+
+    [[nodiscard]] std::string read_file(const std::filesystem::path& path);
+    // write then rename so a concurrent reader never sees a partial file
+    void write_file(const std::filesystem::path& path, std::string_view data);
+    // content without the comment lines of a generated cmake file, used to detect meaningful changes
+    [[nodiscard]] std::string cmake_content(std::string_view data);
+
+    using path_replacements = std::vector<std::pair<std::string, std::string>>;
+    // absolute path spellings of a directory, longest first, used to relocate cached files
+    [[nodiscard]] path_replacements directory_spellings(const std::filesystem::path& directory, const std::string& placeholder);
+    // replace every spelling in text files, a directory is processed recursively
+    void relocate_files(const std::filesystem::path& path, const path_replacements& replacements);
+    void relocate(std::string& data, const path_replacements& replacements);
+
+    // persistent key / value store, one "key value" entry per line
+    class cache
+    {
+    public:
+        explicit cache(std::filesystem::path path);
+
+        [[nodiscard]] std::string get(const std::string& key) const;
+        void set(const std::string& key, std::string value);
+        void clear();
+        void save() const;
+
+        [[nodiscard]] const std::filesystem::path& path() const { return path_; }
+
+    private:
+        std::filesystem::path path_;
+        std::map<std::string, std::string> entries_;
+    };
+} // xc
+
+#endif // INCLUDE_XC_CACHE_HPP_XCMAKE
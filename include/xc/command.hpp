@@ -0,0 +1,73 @@
+#ifndef INCLUDE_XC_COMMAND_HPP_XCMAKE
+#define INCLUDE_XC_COMMAND_HPP_XCMAKE
+
+#include <xc/parameter.hpp>
+#include <xc/small_vector.hpp>
+
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace xc
+{
+    enum class command_mode
+    {
+        run, // no argument
+        version,
+        try_compile, // generation of a compiler probe project
+        generate,
+        build,
+        last_errors, // query of the diagnostics log
+        unknown
+    };
+
+    [[nodiscard]] std::string_view to_string(xc::command_mode mode);
+
+    // -D<name>[:<type>]=<value>
+    struct command_entry
+    {
+        std::string_view name;
+        std::string_view type;
+        std::string_view value;
+        xc::parameter_type kind{ xc::parameter_type::user };
+    };
+
+    // flag not handled by xc, kept to detect changes of the command line
+    struct command_option
+    {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    // cmake command line, every string is a view into the parsed arguments
+    struct command
+    {
+        using entry = xc::command_entry;
+        using option = xc::command_option;
+
+        command_mode mode{ command_mode::run };
+        std::string_view source_directory;
+        // -B or --build
+        std::string_view build_directory;
+        std::string_view generator;
+        // CMAKE_BUILD_TYPE or --config
+        std::string_view build_type;
+        // first argument which is not a flag, the source directory of "cmake <dir>"
+        std::string_view positional;
+        xc::small_vector<std::string_view, 4> targets;
+        // --parallel / -j, 0 when not specified
+        unsigned parallel{ 0 };
+        bool clean_first{ false };
+        bool verbose{ false };
+        xc::small_vector<entry, 16> entries;
+        xc::small_vector<option, 4> options;
+
+        [[nodiscard]] const entry* find(std::string_view name) const;
+        [[nodiscard]] std::string_view value(std::string_view name, std::string_view default_value = {}) const;
+    };
+
+    // the arguments must outlive the command
+    [[nodiscard]] command parse_command(std::span<const std::string> args);
+} // xc
+
+#endif // INCLUDE_XC_COMMAND_HPP_XCMAKE
@@ -0,0 +1,62 @@
+#ifndef INCLUDE_XC_CONSOLE_HPP_XCMAKE
+#define INCLUDE_XC_CONSOLE_HPP_XCMAKE
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace xc
+{
+    // buffered console output written by a dedicated thread
+    // producers only append to a buffer, the writer swaps it and writes batches of lines
+    class console
+    {
+    public:
+        static console& instance();
+
+        console(const console&) = delete;
+        console& operator=(const console&) = delete;
+        ~console();
+
+        void write(std::string_view data);
+        void write(std::initializer_list<std::string_view> parts);
+        // block until everything written before the call reached the console
+        void flush();
+        // copy the console output to a file
+        void tee(const std::filesystem::path& path);
+        // send the output to sink instead of stdout, nullptr restores stdout
+        void redirect(std::function<void(std::string_view)> sink);
+
+    private:
+        console();
+        void notify();
+        void process();
+
+        static constexpr std::size_t batch_size = 64 * 1024;
+        static constexpr std::chrono::milliseconds batch_delay{ 50 };
+
+        std::mutex mutex_;
+        std::mutex file_mutex_;
+        std::condition_variable write_condition_;
+        std::condition_variable flush_condition_;
+        std::string pending_;
+        std::string writing_;
+        std::uint64_t pending_sequence_{ 0 };
+        std::uint64_t written_sequence_{ 0 };
+        bool flush_requested_{ false };
+        bool stop_{ false };
+        std::FILE* tee_{ nullptr };
+        std::function<void(std::string_view)> sink_;
+        std::thread thread_;
+    };
+} // xc
+
+#endif // INCLUDE_XC_CONSOLE_HPP_XCMAKE
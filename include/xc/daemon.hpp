@@ -0,0 +1,27 @@
+#ifndef INCLUDE_XC_DAEMON_HPP_XCMAKE
+#define INCLUDE_XC_DAEMON_HPP_XCMAKE
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace xc
+{
+    // resident xc process answering the invocations of a build directory through a unix domain socket
+    // the daemon keeps tool probes and file fingerprints in memory between invocations
+    namespace daemon
+    {
+        // socket of the build directory found in args, or a shared one in the user cache directory
+        [[nodiscard]] std::filesystem::path socket_path(const std::vector<std::string>& args);
+
+        // run args in the daemon, started if needed, and stream its output
+        // return nullopt when no daemon can be reached so that the invocation runs in process
+        [[nodiscard]] std::optional<int> forward(const std::string& program, const std::vector<std::string>& args);
+
+        int serve(const std::string& program, const std::filesystem::path& socket_path, std::chrono::seconds idle_timeout);
+    } // daemon
+} // xc
+
+#endif // INCLUDE_XC_DAEMON_HPP_XCMAKE
@@ -0,0 +1,38 @@
+#ifndef INCLUDE_XC_DIAGNOSTIC_HPP_XCMAKE
+#define INCLUDE_XC_DIAGNOSTIC_HPP_XCMAKE
+
+#include <optional>
+#include <string_view>
+
+namespace xc
+{
+    enum class severity
+    {
+        note,
+        warning,
+        error,
+        fatal
+    };
+
+    // compiler diagnostic, views point into the parsed line
+    struct diagnostic
+    {
+        std::string_view file;
+        int line{ 0 };
+        int column{ 0 };
+        xc::severity severity{ xc::severity::note };
+        std::string_view code; // C2065, -Wunused-variable
+        std::string_view message;
+        std::string_view label; // ": error" part of the line
+    };
+
+    // parse gcc / clang "file:line:col: severity: message [-Wcode]"
+    // and msvc "file(line,col): severity CODE: message" in a single pass
+    [[nodiscard]] std::optional<xc::diagnostic> parse_diagnostic(std::string_view line);
+    // record of the compiler or the linker, false for the summary lines of the build tool without location ("error: build failed")
+    // only these records are counted and logged
+    [[nodiscard]] bool is_compiler_record(const xc::diagnostic& diagnostic);
+    [[nodiscard]] std::string_view to_string(xc::severity severity);
+} // xc
+
+#endif // INCLUDE_XC_DIAGNOSTIC_HPP_XCMAKE
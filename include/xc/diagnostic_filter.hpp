@@ -0,0 +1,52 @@
+#ifndef INCLUDE_XC_DIAGNOSTIC_FILTER_HPP_XCMAKE
+#define INCLUDE_XC_DIAGNOSTIC_FILTER_HPP_XCMAKE
+
+#include <xc/diagnostic.hpp>
+#include <xc/function_ref.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace xc
+{
+    // collapse of the repetitive compiler output of a build before it reaches the console
+    // - a warning or an error already printed during the build is dropped with its notes (same header in several units)
+    // - the notes following a diagnostic are printed up to max_notes, a repeated note is dropped
+    // - the gcc context preceding a diagnostic (included from, instantiation chain) keeps its first and last lines
+    // the source lines of a diagnostic follow it, max_notes 0 prints everything
+    class diagnostic_filter
+    {
+    public:
+        using emit_callback = xc::function_ref<void(std::string_view, const std::optional<xc::diagnostic>&)>;
+
+        explicit diagnostic_filter(std::size_t max_notes);
+
+        void add(std::string_view line, const std::optional<xc::diagnostic>& diagnostic, emit_callback emit);
+        // end of the notes of the current diagnostic, before a progress line or at the end of the build
+        void close(emit_callback emit);
+
+        // number of dropped lines
+        [[nodiscard]] std::size_t collapsed() const { return collapsed_; }
+
+    private:
+        void end_group(emit_callback emit);
+        void flush_context(bool print, emit_callback emit);
+
+        std::size_t max_notes_;
+        std::vector<std::string> context_;
+        std::unordered_set<std::string> primaries_;
+        std::unordered_set<std::string> notes_;
+        bool in_group_{ false };
+        bool group_printed_{ false };
+        bool entry_printed_{ false };
+        std::size_t group_notes_{ 0 };
+        std::size_t group_collapsed_{ 0 };
+        std::size_t collapsed_{ 0 };
+    };
+} // xc
+
+#endif // INCLUDE_XC_DIAGNOSTIC_FILTER_HPP_XCMAKE
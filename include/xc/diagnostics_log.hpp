@@ -0,0 +1,71 @@
+#ifndef INCLUDE_XC_DIAGNOSTICS_LOG_HPP_XCMAKE
+#define INCLUDE_XC_DIAGNOSTICS_LOG_HPP_XCMAKE
+
+#include <xc/diagnostic.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xc
+{
+    // diagnostics of the last builds of a build directory, <build directory>/.xc/diagnostics.log
+    // binary append-only file : a header then one record per build followed by one record per diagnostic
+    // the oldest builds are dropped when a build is appended to a full log
+
+    struct logged_diagnostic
+    {
+        xc::severity severity{ xc::severity::note };
+        int line{ 0 };
+        int column{ 0 };
+        std::string_view file;
+        std::string_view target; // owning target of the file when xmake targets were dumped, empty otherwise
+        std::string_view code;
+        std::string_view message;
+    };
+
+    struct logged_build
+    {
+        std::int64_t time{ 0 }; // seconds since epoch
+        int exit_code{ 0 };
+        std::string_view mode;
+        std::string_view targets;
+        std::vector<logged_diagnostic> diagnostics;
+    };
+
+    // diagnostics of the running build, written to the log once the build finished
+    class diagnostics_writer
+    {
+    public:
+        void add(const xc::diagnostic& diagnostic, std::string_view target);
+        // append the build and keep the last max_builds builds
+        void save(const std::filesystem::path& path, std::string_view mode, std::string_view targets, int exit_code, std::size_t max_builds) const;
+
+    private:
+        std::string records_;
+    };
+
+    // read only view of the log mapped in memory, the views of the builds point into the mapping
+    class diagnostics_log
+    {
+    public:
+        explicit diagnostics_log(const std::filesystem::path& path);
+        ~diagnostics_log();
+
+        diagnostics_log(const diagnostics_log&) = delete;
+        diagnostics_log& operator=(const diagnostics_log&) = delete;
+
+        // oldest first
+        [[nodiscard]] const std::vector<logged_build>& builds() const { return builds_; }
+
+    private:
+        const char* data_{ nullptr };
+        std::size_t size_{ 0 };
+        std::string buffer_; // content read without mapping on windows
+        std::vector<logged_build> builds_;
+    };
+} // xc
+
+#endif // INCLUDE_XC_DIAGNOSTICS_LOG_HPP_XCMAKE
@@ -0,0 +1,20 @@
+#ifndef INCLUDE_XC_FILE_API_HPP_XCMAKE
+#define INCLUDE_XC_FILE_API_HPP_XCMAKE
+
+#include <xc/project.hpp>
+
+#include <filesystem>
+#include <string>
+
+namespace xc
+{
+    // write the codemodel-v2 and cmakeFiles-v1 objects of a cmake file api reply from the xmake targets
+    // the index, cache-v2 and toolchains-v1 objects of the reply written by the last cmake run are reused
+    // return false when there is no such reply
+    bool write_file_api_reply(const std::filesystem::path& source_directory,
+                              const std::filesystem::path& build_directory,
+                              const std::string& configuration,
+                              const xc::project_info& project);
+} // xc
+
+#endif // INCLUDE_XC_FILE_API_HPP_XCMAKE
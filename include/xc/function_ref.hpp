@@ -0,0 +1,33 @@
+#ifndef INCLUDE_XC_FUNCTION_REF_HPP_XCMAKE
+#define INCLUDE_XC_FUNCTION_REF_HPP_XCMAKE
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+namespace xc
+{
+    template<class Signature>
+    class function_ref;
+
+    // non owning callable reference, the referenced callable must outlive the call
+    template<class R, class... Args>
+    class function_ref<R(Args...)>
+    {
+    public:
+        template<class F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref> && std::is_invocable_r_v<R, F&, Args...>)
+        function_ref(F&& f) noexcept
+            : object_{ const_cast<void*>(static_cast<const void*>(std::addressof(f))) }
+            , call_{ [](void* object, Args... args) -> R { return std::invoke(*static_cast<std::remove_reference_t<F>*>(object), std::forward<Args>(args)...); } }
+        {}
+
+        R operator()(Args... args) const { return call_(object_, std::forward<Args>(args)...); }
+
+    private:
+        void* object_;
+        R (*call_)(void*, Args...);
+    };
+} // xc
+
+#endif // INCLUDE_XC_FUNCTION_REF_HPP_XCMAKE
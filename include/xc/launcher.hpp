@@ -0,0 +1,30 @@
+#ifndef INCLUDE_XC_LAUNCHER_HPP_XCMAKE
+#define INCLUDE_XC_LAUNCHER_HPP_XCMAKE
+
+#include <xc/function_ref.hpp>
+#include <xc/tool.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace xc
+{
+    // native process launcher (linux) : posix_spawn with close-on-exec pipes, the calling thread drains stdout and stderr
+    // with a single poll loop into a reusable 64 KiB buffer, no reader thread and no allocation per read
+    // the child leads its own process group and reads an empty stdin, the program is searched in PATH
+    // other platforms use TinyProcessLib
+    using output_reader = xc::function_ref<void(const char*, std::size_t)>;
+
+    // return the exit code of the process, 128 + signal when it was killed and 127 when it could not be started
+    // started receives the pid of the running process, environment overrides the variables of the current process
+    int launch(const std::vector<std::string>& args,
+               const std::string& working_directory,
+               const xc::environment& environment,
+               xc::function_ref<void(std::int64_t)> started,
+               xc::output_reader read_stdout,
+               xc::output_reader read_stderr);
+} // xc
+
+#endif // INCLUDE_XC_LAUNCHER_HPP_XCMAKE
@@ -0,0 +1,59 @@
+#ifndef INCLUDE_XC_LINE_FRAMER_HPP_XCMAKE
+#define INCLUDE_XC_LINE_FRAMER_HPP_XCMAKE
+
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace xc
+{
+    // split a stream of chunks into lines without the line terminator
+    // complete lines of a chunk are passed as views of the chunk, only a partial line is copied
+    class line_framer
+    {
+    public:
+        template<class F>
+        void feed(std::string_view data, F&& on_line)
+        {
+            while (!data.empty())
+            {
+                auto newline = static_cast<const char*>(std::memchr(data.data(), '\n', data.size()));
+                if (!newline)
+                {
+                    buffer_.append(data);
+                    return;
+                }
+
+                auto size = static_cast<std::size_t>(newline - data.data());
+                if (buffer_.empty()) on_line(trim(data.substr(0, size)));
+                else
+                {
+                    buffer_.append(data.substr(0, size));
+                    on_line(trim(buffer_));
+                    buffer_.clear();
+                }
+                data.remove_prefix(size + 1);
+            }
+        }
+
+        // emit the last line when the stream ends without a newline
+        template<class F>
+        void flush(F&& on_line)
+        {
+            if (buffer_.empty()) return;
+            on_line(trim(buffer_));
+            buffer_.clear();
+        }
+
+    private:
+        static std::string_view trim(std::string_view line)
+        {
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            return line;
+        }
+
+        std::string buffer_;
+    };
+} // xc
+
+#endif // INCLUDE_XC_LINE_FRAMER_HPP_XCMAKE
@@ -1,7 +1,13 @@
 #ifndef INCLUDE_XC_MAPPING_HPP_XCMAKE
 #define INCLUDE_XC_MAPPING_HPP_XCMAKE
 
+#include <xc/command.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace xc
 {
@@ -11,6 +17,43 @@ namespace xc
         { "RelWithDebInfo", "releasedbg" },
         { "MinSizeRel", "minsizerel" },
     };
-} // xcmake
 
-#endif // INCLUDE_XC_MAPPING_HPP_XCMAKE
\ No newline at end of file
+    // cmake cache entries translated to xmake config options
+    struct cmake_mapping
+    {
+        enum class kind
+        {
+            launcher, // enabled when the program is ccache
+            flag // enabled when the value is on
+        };
+
+        std::string_view entry;
+        cmake_mapping::kind kind;
+        // xmake config option and its value when the entry is enabled, empty when xmake has no equivalent
+        std::string_view option;
+        std::string_view value;
+        std::string_view note;
+    };
+
+    inline constexpr std::array cmake_mappings{
+        cmake_mapping{ "CMAKE_C_COMPILER_LAUNCHER", cmake_mapping::kind::launcher, "ccache", "y", "only ccache is supported by xmake" },
+        cmake_mapping{ "CMAKE_CXX_COMPILER_LAUNCHER", cmake_mapping::kind::launcher, "ccache", "y", "only ccache is supported by xmake" },
+        cmake_mapping{ "CMAKE_INTERPROCEDURAL_OPTIMIZATION", cmake_mapping::kind::flag, "policies", "build.optimization.lto", {} },
+        cmake_mapping{ "CMAKE_UNITY_BUILD", cmake_mapping::kind::flag, {}, {}, "add the c++.unity_build rule to the xmake targets" },
+        cmake_mapping{ "CMAKE_DISABLE_PRECOMPILE_HEADERS", cmake_mapping::kind::flag, {}, {}, "precompiled headers are declared by set_pcxxheader in xmake.lua" },
+    };
+
+    // mapping applied to an entry of the command line
+    struct applied_mapping
+    {
+        std::string_view entry;
+        std::string_view value;
+        std::string_view option; // empty when the entry is not supported
+        std::string_view option_value;
+        std::string_view note;
+    };
+
+    [[nodiscard]] std::vector<xc::applied_mapping> map_cmake_entries(const xc::command& command);
+} // xc
+
+#endif // INCLUDE_XC_MAPPING_HPP_XCMAKE
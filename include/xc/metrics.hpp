@@ -0,0 +1,30 @@
+#ifndef INCLUDE_XC_METRICS_HPP_XCMAKE
+#define INCLUDE_XC_METRICS_HPP_XCMAKE
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace xc
+{
+    // measures of a child process started by xc
+    struct run_metrics
+    {
+        std::string_view phase; // mode of the invocation : generate, build, try_compile ...
+        std::string_view program;
+        std::string_view command; // first argument, the xmake task
+        int exit_code{ 0 };
+        std::chrono::system_clock::time_point start;
+        std::chrono::microseconds spawn{ 0 }; // until the process is started
+        std::chrono::microseconds first_output{ -1 }; // -1 without output
+        std::chrono::microseconds total{ 0 };
+        std::size_t bytes{ 0 };
+        std::size_t lines{ 0 };
+    };
+
+    // append the metrics as a json line, safe to call from several threads and processes
+    void write_metrics(const std::filesystem::path& path, const xc::run_metrics& metrics);
+} // xc
+
+#endif // INCLUDE_XC_METRICS_HPP_XCMAKE
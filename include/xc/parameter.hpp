@@ -1,22 +1,14 @@
 #ifndef INCLUDE_XC_PARAMETER_HPP_XCMAKE
 #define INCLUDE_XC_PARAMETER_HPP_XCMAKE
 
-#include <string>
-
 namespace xc
 {
+    // kind of a -D cache entry
     enum class parameter_type
     {
-        cmake,
         user,
-        user_cmake // starting with CMAKE_
-    };
-
-    struct parameter
-    {
-        std::string name;
-        std::string value;
-        parameter_type type{ parameter_type::cmake };
+        user_cmake, // starting with CMAKE_
+        user_xc // starting with XC_, options of xc itself
     };
 } // xc
 
@@ -0,0 +1,62 @@
+#ifndef INCLUDE_XC_PROGRESS_HPP_XCMAKE
+#define INCLUDE_XC_PROGRESS_HPP_XCMAKE
+
+#include <chrono>
+#include <optional>
+#include <string_view>
+
+namespace xc
+{
+    // xmake progress line "[ 45%]: cache compiling.release src/main.cpp", views point into the line
+    struct progress
+    {
+        int percent{ 0 };
+        std::string_view action; // compiling, linking, archiving
+        std::string_view mode;
+        std::string_view name;
+        bool cached{ false };
+    };
+
+    [[nodiscard]] inline std::optional<xc::progress> parse_progress(std::string_view line)
+    {
+        if (!line.starts_with('[')) return std::nullopt;
+        auto end = line.find("%]:");
+        if (end == std::string_view::npos || end > 6) return std::nullopt;
+
+        xc::progress progress;
+        for (auto c : line.substr(1, end - 1))
+        {
+            if (c >= '0' && c <= '9') progress.percent = progress.percent * 10 + (c - '0');
+            else if (c != ' ') return std::nullopt;
+        }
+
+        auto rest = line.substr(end + 3);
+        while (rest.starts_with(' ')) rest.remove_prefix(1);
+        if (rest.starts_with("cache "))
+        {
+            progress.cached = true;
+            rest.remove_prefix(6);
+        }
+
+        auto space = rest.find(' ');
+        auto dot = rest.find('.');
+        if (space == std::string_view::npos || dot == std::string_view::npos || dot > space) return std::nullopt;
+        progress.action = rest.substr(0, dot);
+        progress.mode = rest.substr(dot + 1, space - dot - 1);
+        progress.name = rest.substr(space + 1);
+        return progress;
+    }
+
+    enum class progress_mode
+    {
+        line, // progress lines replace each other on a single status line
+        full // every progress line is printed
+    };
+
+    // XC_PROGRESS=auto|line|full, auto uses the status line on a terminal or in the CLion console
+    [[nodiscard]] xc::progress_mode detect_progress_mode();
+    // XC_PROGRESS_INTERVAL, minimum delay between two refreshes of the status line
+    [[nodiscard]] std::chrono::milliseconds progress_interval();
+} // xc
+
+#endif // INCLUDE_XC_PROGRESS_HPP_XCMAKE
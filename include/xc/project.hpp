@@ -0,0 +1,63 @@
+#ifndef INCLUDE_XC_PROJECT_HPP_XCMAKE
+#define INCLUDE_XC_PROJECT_HPP_XCMAKE
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xc
+{
+    // targets of the xmake project, dumped by project_script with xmake lua
+    struct project_target
+    {
+        // sources of one xmake source kind (cc, cxx, mm ...) compiled with the same flags
+        struct group
+        {
+            std::string kind;
+            std::vector<std::string> sources;
+            std::vector<std::string> includes;
+            std::vector<std::string> system_includes;
+            std::vector<std::string> defines;
+            std::vector<std::string> flags;
+        };
+
+        std::string name;
+        std::string kind;
+        std::string output;
+        std::vector<std::string> deps;
+        std::vector<group> groups;
+    };
+
+    struct project_info
+    {
+        std::string name;
+        // xmake.lua and included files
+        std::vector<std::string> inputs;
+        std::vector<project_target> targets;
+    };
+
+    // lua script run by "xmake lua <script> <output>" from the project directory
+    extern const std::string_view project_script;
+
+    [[nodiscard]] project_info read_project_info(const std::filesystem::path& path);
+
+    // source of a target, views into the project info
+    struct project_source
+    {
+        std::string_view target;
+        std::string_view path;
+    };
+
+    // source matching the file, the file can be relative to the project directory
+    [[nodiscard]] std::optional<project_source> find_source(const project_info& info, std::string_view file);
+    // target compiling the source file, empty if none
+    [[nodiscard]] std::string_view owning_target(const project_info& info, std::string_view file);
+
+    // object file target requested by the ide, CMakeFiles/<target>.dir/src/main.cpp.o : <target>, src/main.cpp
+    // the target is empty without the CMakeFiles prefix
+    [[nodiscard]] std::optional<project_source> parse_object_target(std::string_view name);
+} // xc
+
+#endif // INCLUDE_XC_PROJECT_HPP_XCMAKE
@@ -0,0 +1,62 @@
+#ifndef INCLUDE_XC_SMALL_VECTOR_HPP_XCMAKE
+#define INCLUDE_XC_SMALL_VECTOR_HPP_XCMAKE
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace xc
+{
+    // vector storing up to N elements inline, the elements move to the heap beyond
+    // only for trivially copyable types, used for views into the command line
+    template<class T, std::size_t N>
+    class small_vector
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>);
+
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        void push_back(const T& value)
+        {
+            if (size_ < N) inline_[size_] = value;
+            else
+            {
+                if (size_ == N) heap_.assign(inline_.begin(), inline_.end());
+                heap_.push_back(value);
+            }
+            ++size_;
+        }
+
+        void clear()
+        {
+            size_ = 0;
+            heap_.clear();
+        }
+
+        [[nodiscard]] T* data() { return size_ > N ? heap_.data() : inline_.data(); }
+        [[nodiscard]] const T* data() const { return size_ > N ? heap_.data() : inline_.data(); }
+        [[nodiscard]] std::size_t size() const { return size_; }
+        [[nodiscard]] bool empty() const { return size_ == 0; }
+
+        [[nodiscard]] T& operator[](std::size_t index) { return data()[index]; }
+        [[nodiscard]] const T& operator[](std::size_t index) const { return data()[index]; }
+        [[nodiscard]] const T& front() const { return data()[0]; }
+        [[nodiscard]] const T& back() const { return data()[size_ - 1]; }
+
+        [[nodiscard]] iterator begin() { return data(); }
+        [[nodiscard]] iterator end() { return data() + size_; }
+        [[nodiscard]] const_iterator begin() const { return data(); }
+        [[nodiscard]] const_iterator end() const { return data() + size_; }
+
+    private:
+        std::array<T, N> inline_{};
+        std::vector<T> heap_;
+        std::size_t size_{ 0 };
+    };
+} // xc
+
+#endif // INCLUDE_XC_SMALL_VECTOR_HPP_XCMAKE
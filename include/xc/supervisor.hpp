@@ -0,0 +1,42 @@
+#ifndef INCLUDE_XC_SUPERVISOR_HPP_XCMAKE
+#define INCLUDE_XC_SUPERVISOR_HPP_XCMAKE
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace xc
+{
+    // registry of the running child processes, each one leads its own process group
+    // SIGINT and SIGTERM received by xc are forwarded to the groups so that a cancelled build stops its compilers
+    class supervisor
+    {
+    public:
+        static supervisor& instance();
+
+        supervisor(const supervisor&) = delete;
+        supervisor& operator=(const supervisor&) = delete;
+
+        // install the signal handlers, no-op on windows where the console already signals the children
+        void install();
+
+        void add(std::int64_t id);
+        void remove(std::int64_t id);
+        // stop every child process and its descendants
+        void terminate();
+
+        // signal which cancelled xc, 0 if none
+        [[nodiscard]] int signal() const { return signal_.load(); }
+
+    private:
+        supervisor() = default;
+        static void forward(int signal);
+
+        // fixed size and lock free, the registry is read from the signal handler
+        static constexpr std::size_t capacity = 64;
+        std::array<std::atomic<std::int64_t>, capacity> children_{};
+        std::atomic<int> signal_{ 0 };
+    };
+} // xc
+
+#endif // INCLUDE_XC_SUPERVISOR_HPP_XCMAKE
@@ -0,0 +1,52 @@
+#ifndef INCLUDE_XC_TIMELINE_HPP_XCMAKE
+#define INCLUDE_XC_TIMELINE_HPP_XCMAKE
+
+#include <xc/progress.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace xc
+{
+    // build jobs timestamped from the xmake progress lines
+    // xmake only reports when a job starts : the end of a job is only known in a serial build (-j 1) where it is the start of the next job
+    // the jobs of a parallel build are written as instant events without duration
+    class timeline
+    {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        struct job
+        {
+            std::string name;
+            std::string action;
+            clock::time_point start;
+            std::optional<clock::time_point> end; // measured end, serial builds only
+        };
+
+        // jobs of the build, 0 for the xmake default
+        explicit timeline(std::size_t jobs);
+
+        void add(const xc::progress& progress);
+        void finish();
+
+        // true when the jobs have a measured end
+        [[nodiscard]] bool serial() const { return serial_; }
+
+        // chrome://tracing / perfetto json
+        void write_trace(const std::filesystem::path& path) const;
+        // empty for a parallel build
+        [[nodiscard]] std::vector<const job*> slowest(std::size_t count) const;
+
+    private:
+        bool serial_;
+        clock::time_point start_;
+        std::vector<job> jobs_;
+    };
+} // xc
+
+#endif // INCLUDE_XC_TIMELINE_HPP_XCMAKE
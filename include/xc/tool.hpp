@@ -0,0 +1,43 @@
+#ifndef INCLUDE_XC_TOOL_HPP_XCMAKE
+#define INCLUDE_XC_TOOL_HPP_XCMAKE
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace xc
+{
+    // resolve a program name using PATH, empty if not found
+    [[nodiscard]] std::filesystem::path find_program(const std::string& name);
+    // path, size and modification time of a binary, changes when the binary is replaced
+    [[nodiscard]] std::string program_identity(const std::filesystem::path& path);
+    using environment = std::unordered_map<std::string, std::string>;
+    // environment of the current process with overrides applied
+    [[nodiscard]] xc::environment process_environment(const xc::environment& overrides);
+
+    // start a process outliving the current one, its output is discarded
+    bool spawn_detached(const std::vector<std::string>& args);
+    // absolute path of the running executable
+    [[nodiscard]] std::filesystem::path current_executable(const std::string& argv0);
+
+    // user cache directory of xc, shared by every project
+    [[nodiscard]] std::filesystem::path cache_directory();
+
+    // exclusive lock on a file held until destruction, blocks while another process holds it
+    // no-op on windows
+    class file_lock
+    {
+    public:
+        explicit file_lock(const std::filesystem::path& path);
+        ~file_lock();
+
+        file_lock(const file_lock&) = delete;
+        file_lock& operator=(const file_lock&) = delete;
+
+    private:
+        int fd_{ -1 };
+    };
+} // xc
+
+#endif // INCLUDE_XC_TOOL_HPP_XCMAKE
@@ -1,13 +1,21 @@
 #ifndef INCLUDE_XC_UTILITY_HPP_XCMAKE
 #define INCLUDE_XC_UTILITY_HPP_XCMAKE
 
-
-#include <xc/parameter.hpp>
-
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#endif
+
+#include <cctype>
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <ranges>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <iomanip>
@@ -39,115 +47,121 @@ namespace xc
         return ss.str();
     }
 
-    inline std::string clean_colors(const std::string& input)
+    // offset of the next ESC byte at or after offset, input size if none
+    inline std::size_t find_escape(std::string_view input, std::size_t offset)
     {
-        std::string output;
-        bool skip = false;
-        for (char c : input)
+#if defined(__AVX2__)
+        const __m256i escape = _mm256_set1_epi8('\033');
+        for (; offset + 32 <= input.size(); offset += 32)
         {
-            if (c == '\033')
-            {
-                skip = true;
-                continue;
-            }
-            else if (skip)
-            {
-                if (c == 'm') skip = false;
-            }
-            else output += c;
+            auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + offset));
+            auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, escape)));
+            if (mask) return offset + std::countr_zero(mask);
         }
-        return output;
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        const __m128i escape16 = _mm_set1_epi8('\033');
+        for (; offset + 16 <= input.size(); offset += 16)
+        {
+            auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + offset));
+            auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, escape16)));
+            if (mask) return offset + std::countr_zero(mask);
+        }
+#endif
+        if (offset >= input.size()) return input.size();
+        auto found = static_cast<const char*>(std::memchr(input.data() + offset, '\033', input.size() - offset));
+        return found ? static_cast<std::size_t>(found - input.data()) : input.size();
     }
 
-    inline std::pair<std::string, std::string> parse_user_parameter(const std::string& data)
+    // size of the escape sequence starting at offset (ECMA-48)
+    inline std::size_t escape_size(std::string_view input, std::size_t offset)
     {
-        auto offset = data.find('=');
-        if (offset == std::string::npos || offset + 1 >= data.size()) throw std::logic_error{ "parse_user_parameter " + data };
+        auto size = input.size();
+        auto i = offset + 1;
+        if (i >= size) return 1;
 
-        return { data.substr(0, offset), data.substr(offset + 1) };
+        auto in_range = [&input, size](std::size_t i, char first, char last) { return i < size && input[i] >= first && input[i] <= last; };
+        switch (input[i])
+        {
+        // CSI : parameter bytes, intermediate bytes, final byte
+        case '[':
+            ++i;
+            while (in_range(i, 0x30, 0x3F)) ++i;
+            while (in_range(i, 0x20, 0x2F)) ++i;
+            if (in_range(i, 0x40, 0x7E)) ++i;
+            return i - offset;
+        // OSC, DCS, SOS, PM, APC : string terminated by BEL or ST
+        case ']':
+        case 'P':
+        case 'X':
+        case '^':
+        case '_':
+            for (++i; i < size; ++i)
+            {
+                if (input[i] == '\a') return i + 1 - offset;
+                if (input[i] == '\033' && i + 1 < size && input[i + 1] == '\\') return i + 2 - offset;
+            }
+            return size - offset;
+        // intermediate bytes then a final byte, or a single final byte
+        default:
+            while (in_range(i, 0x20, 0x2F)) ++i;
+            if (i < size) ++i;
+            return i - offset;
+        }
     }
 
-    inline std::vector<xc::parameter> cmake_parse_args(std::vector<std::string> args)
+    // remove every escape sequence, not only colors
+    inline std::string clean_colors(std::string_view input)
     {
-        std::vector<xc::parameter> parameters;
+        auto escape = find_escape(input, 0);
+        if (escape == input.size()) return std::string{ input };
 
-        for (int i = 0; i < args.size(); ++i)
+        std::string output;
+        output.reserve(input.size());
+        std::size_t offset = 0;
+        while (escape < input.size())
         {
-            auto& arg = args[i];
-            xc::parameter parameter;
+            output.append(input.substr(offset, escape - offset));
+            offset = escape + escape_size(input, escape);
+            escape = find_escape(input, offset);
+        }
+        if (offset < input.size()) output.append(input.substr(offset));
+        return output;
+    }
 
-            if (!arg.empty() && arg[0] == '-')
+    inline std::string json_escape(std::string_view data)
+    {
+        std::string output;
+        output.reserve(data.size());
+        for (char c : data)
+        {
+            switch (c)
             {
-                if (arg.size() > 1)
+            case '"': output += "\\\""; break;
+            case '\\': output += "\\\\"; break;
+            case '\n': output += "\\n"; break;
+            case '\r': output += "\\r"; break;
+            case '\t': output += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
                 {
-                    if (arg[1] == '-')
-                    {
-                        parameter.name = arg.substr(2);
-                        if (i + 1 >= args.size())
-                        {
-                            parameters.emplace_back(std::move(parameter));
-                            break;
-                        }
-
-                        ++i;
-                        parameter.value = args[i];
-                        parameters.emplace_back(std::move(parameter));
-                        continue;
-                    }
-                    else if (arg[1] > 'A' && arg[1] < 'Z')
-                    {
-                        if (arg[1] == 'D') parameter.type = xc::parameter_type::user;
-
-                        if (arg.size() == 2)
-                        {
-                            ++i;
-                            if (parameter.type == xc::parameter_type::user)
-                            {
-                                auto [user_parameter, user_value] = parse_user_parameter(args[i]);
-                                if (user_parameter.starts_with("CMAKE_")) parameter.type = xc::parameter_type::user_cmake;
-                                parameter.name = user_parameter;
-                                parameter.value = user_value;
-                            }
-                            else
-                            {
-                                parameter.name = arg[1];
-                                parameter.value = args[i];
-                            }
-                            parameters.emplace_back(std::move(parameter));
-                            continue;
-                        }
-                        else
-                        {
-                            if (parameter.type == xc::parameter_type::user)
-                            {
-                                auto [user_parameter, user_value] = parse_user_parameter(arg.substr(2));
-                                if (user_parameter.starts_with("CMAKE_")) parameter.type = xc::parameter_type::user_cmake;
-                                parameter.name = user_parameter;
-                                parameter.value = user_value;
-                            }
-                            else
-                            {
-                                parameter.name = arg[1];
-                                parameter.value = arg.substr(2);
-                            }
-                            parameters.emplace_back(std::move(parameter));
-                        }
-                    }
-                    else
-                    {
-                        parameter.name = arg.substr(1);
-                        parameters.emplace_back(std::move(parameter));
-                    }
+                    constexpr char hex[] = "0123456789abcdef";
+                    output += "\\u00";
+                    output += hex[(c >> 4) & 0xf];
+                    output += hex[c & 0xf];
                 }
-            }
-            else
-            {
-                parameter.value = arg;
-                parameters.emplace_back(std::move(parameter));
+                else output += c;
             }
         }
+        return output;
+    }
 
-        return parameters;
+    // cmake boolean semantic
+    inline bool is_on(std::string_view value)
+    {
+        std::string upper;
+        for (char c : value) upper += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        return upper == "ON" || upper == "1" || upper == "TRUE" || upper == "YES" || upper == "Y";
     }
 } // xc
 
@@ -0,0 +1,23 @@
+#ifndef INCLUDE_XC_WATCH_HPP_XCMAKE
+#define INCLUDE_XC_WATCH_HPP_XCMAKE
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace xc
+{
+    // background xc process of a build directory regenerating the xmake configuration and the cmakelists
+    // when a lua file of the project changes, the next generation finds its stages fresh (linux only)
+    namespace watch
+    {
+        // start the watcher of the build directory when enabled and not running, stop it otherwise
+        void update(const std::string& program, const std::filesystem::path& build_directory, bool enabled);
+
+        // watch the lua files of the profile stored in the build directory
+        // changes are debounced, the watcher exits when its pid file is removed or taken by another watcher
+        int serve(const std::string& program, const std::filesystem::path& build_directory, std::chrono::milliseconds delay);
+    } // watch
+} // xc
+
+#endif // INCLUDE_XC_WATCH_HPP_XCMAKE
@@ -1,76 +1,116 @@
 #ifndef XC_XCMAKE_HPP_XCMAKE
 #define XC_XCMAKE_HPP_XCMAKE
 
-#include <xc/parameter.hpp>
+#include <xc/command.hpp>
+#include <xc/console.hpp>
+#include <xc/diagnostic.hpp>
+#include <xc/function_ref.hpp>
+#include <xc/tool.hpp>
 #include <xc/utility.hpp>
 
 
 #include <fmt/core.h>
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <ranges>
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace xc
 {
     class xcmake
     {
-        using output_callback = std::function<void(std::string)>;
+        // receive one line of output without the line terminator
+        using output_callback = xc::function_ref<void(std::string_view)>;
+        using logger = std::function<void(std::string_view)>;
 
     public:
         xcmake(std::string program, std::vector<std::string> args);
         xcmake(const xcmake&) = delete;
         xcmake& operator=(const xcmake&) = delete;
 
-        void process();
+        // return the exit code of xc
+        int process();
 
-        void build();
-        void generate();
+        int build();
+        int generate();
+        // configure and cmakelists stages of generate, run by the watcher
+        int pregenerate();
+        int try_compile();
+        int last_errors();
 
-        // run
-        void run(
+        // run, return the exit code of the process
+        int run(
             std::vector<std::string>& reproc_args,
-            const xcmake::output_callback& = [](std::string data) {}) const;
-        void run(
+            xcmake::output_callback = [](std::string_view) {}) const;
+        int run(
+            std::vector<std::string>& reproc_args,
+            const xc::environment& environment,
+            xcmake::output_callback = [](std::string_view) {}) const;
+        int run(
+            std::string_view program,
+            const std::vector<std::string>& args,
+            const xc::environment& environment,
+            xcmake::output_callback = [](std::string_view) {}) const;
+        int run(
             std::string_view program,
             const std::vector<std::string>& args,
-            const xcmake::output_callback& = [](std::string data) {}) const;
-        void run(
+            xcmake::output_callback = [](std::string_view) {}) const;
+        int run(
             std::string_view program,
             const char* args,
-            const xcmake::output_callback& = [](std::string data) {}) const;
+            xcmake::output_callback = [](std::string_view) {}) const;
 
         template<typename... Args>
         void error(std::string_view message, Args&&...) const;
         template<typename... Args>
         void log(std::string_view message, Args&&...) const;
-        void log_cmake(std::string message) const;
-        void log_xmake(std::string message, bool single_line = false) const;
+        void log_cmake(std::string_view message) const;
+        void log_xmake(std::string_view message, bool single_line = false) const;
+        void log_xmake(std::string_view message, const std::optional<xc::diagnostic>& diagnostic, bool single_line) const;
 
         void xmake_configure() const;
 
-        [[nodiscard]] const xc::parameter& parameter(const std::string& name) const;
-        [[nodiscard]] std::string parameter_value(const std::string& name, const std::string& default_value = "") const;
-        [[nodiscard]] bool has_parameter(const std::string& name, xc::parameter_type t = xc::parameter_type::cmake) const;
+        [[nodiscard]] const xc::command& command() const { return command_; }
 
         [[nodiscard]] std::string cmake_version() const;
         [[nodiscard]] std::string xmake_version() const;
+        [[nodiscard]] std::string tool_version(const std::string& program, const std::function<std::string(const std::string&)>& parse) const;
 
         [[nodiscard]] std::string color(const std::string& data, const std::string& color) const;
 
     private:
+        // generation inputs of a cmake profile
+        struct profile
+        {
+            std::string build_directory;
+            std::vector<std::string> args;
+            std::string mode;
+            std::string config_file;
+        };
+
+        // arguments of xc forwarded to cmake
+        [[nodiscard]] std::vector<std::string> cmake_args() const;
+        [[nodiscard]] std::vector<std::string> xmake_config_args(const profile&) const;
+        [[nodiscard]] std::vector<profile> sibling_profiles(const std::string& source_directory, const std::string& build_directory) const;
+
         std::string program_;
         std::vector<std::string> args_;
-        std::vector<xc::parameter> parameters_;
+        // views into args_
+        xc::command command_;
 
         std::string working_directory_;
         bool colorize_console_;
         bool verbose_;
+        bool pregenerate_;
+        // tag of the metrics of the child processes
+        std::string_view phase_;
 
-        output_callback clogger_;
-        output_callback xlogger_;
+        logger clogger_;
+        logger xlogger_;
 
         int errors_count_;
         int warnings_count_;
@@ -82,13 +122,15 @@ namespace xc
     template<typename... Args>
     void xcmake::error(std::string_view message, Args&&... args) const
     {
-        std::cout << "[xc] [xc:" + color("error", "101") + "] " << fmt::vformat(message, fmt::make_format_args(args...)) << std::endl;
+        auto& console = xc::console::instance();
+        console.write({ "[xc] [xc:", color("error", "101"), "] ", fmt::vformat(message, fmt::make_format_args(args...)), "\n" });
+        console.flush();
     }
 
     template<typename... Args>
     void xcmake::log(std::string_view message, Args&&... args) const
     {
-        std::cout << color("[xc]", "34") << " " << fmt::vformat(message, fmt::make_format_args(args...)) << std::endl;
+        xc::console::instance().write({ color("[xc]", "34"), " ", fmt::vformat(message, fmt::make_format_args(args...)), "\n" });
     }
 } // xc
 
@@ -1,24 +1,52 @@
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <fstream>
 
+#include <xc/daemon.hpp>
+#include <xc/supervisor.hpp>
+#include <xc/watch.hpp>
 #include <xc/xcmake.hpp>
 
 int main(int argc, char* argv[])
 {
     std::vector<std::string> args(argv + 1, argv + argc);
+    xc::supervisor::instance().install();
 
+    // resident server started by a client invocation
+    if (args.size() == 2 && args[0] == "--xc-daemon")
+    {
+        const char* idle = std::getenv("XC_DAEMON_IDLE");
+        return xc::daemon::serve(argv[0], args[1], std::chrono::seconds{ idle ? std::atoi(idle) : 600 });
+    }
+    // background generation of a build directory started by -DXC_WATCH=ON
+    if (args.size() == 2 && args[0] == "--xc-watch")
+    {
+        const char* delay = std::getenv("XC_WATCH_DELAY");
+        return xc::watch::serve(argv[0], args[1], std::chrono::milliseconds{ delay ? std::atoi(delay) : 300 });
+    }
+    if (const char* daemon = std::getenv("XC_DAEMON"); daemon && xc::is_on(daemon))
+    {
+        if (auto exit_code = xc::daemon::forward(argv[0], args)) return *exit_code;
+    }
+
+    int exit_code = 0;
     try
     {
         xc::xcmake xcmake{ std::string{ argv[0] }, std::move(args) };
 
-        xcmake.process();
+        exit_code = xcmake.process();
     }
     catch (const std::exception& e)
     {
-        std::cout << "xc exception: " << e.what();
+        xc::console::instance().write({ "xc exception: ", e.what() });
+        exit_code = 1;
     }
+    xc::console::instance().flush();
 
-    return 0;
-}
\ No newline at end of file
+    // shell convention for a process stopped by a signal
+    if (auto signal = xc::supervisor::instance().signal()) return 128 + signal;
+    return exit_code;
+}
@@ -0,0 +1,241 @@
+#include <xc/cache.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace xc
+{
+    fingerprint& fingerprint::add(std::string_view data)
+    {
+        for (unsigned char c : data)
+        {
+            value_ ^= c;
+            value_ *= 1099511628211ull;
+        }
+        // separator so that ("ab", "c") and ("a", "bc") differ
+        value_ ^= 0xff;
+        value_ *= 1099511628211ull;
+        return *this;
+    }
+
+    fingerprint& fingerprint::add_file(const std::filesystem::path& path)
+    {
+        std::ifstream ifs{ path, std::ios::binary };
+        if (!ifs) return add("<missing>");
+
+        char buffer[65536];
+        while (ifs.read(buffer, sizeof(buffer)) || ifs.gcount() > 0)
+        {
+            for (std::streamsize i = 0; i < ifs.gcount(); ++i)
+            {
+                value_ ^= static_cast<unsigned char>(buffer[i]);
+                value_ *= 1099511628211ull;
+            }
+        }
+        return add(path.generic_string());
+    }
+
+    std::string fingerprint::str() const { return fmt::format("{:016x}", value_); }
+
+    std::string file_fingerprint(const std::filesystem::path& path)
+    {
+        if (!std::filesystem::exists(path)) return {};
+        return fingerprint{}.add_file(path).str();
+    }
+
+    std::string xmake_state_fingerprint(const std::filesystem::path& root)
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code ec;
+        std::vector<fs::path> files;
+        for (const auto& plat : fs::directory_iterator{ root / ".xmake", ec })
+        {
+            for (const auto& arch : fs::directory_iterator{ plat.path(), ec })
+            {
+                if (fs::exists(arch.path() / "xmake.conf", ec)) files.emplace_back(arch.path() / "xmake.conf");
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        xc::fingerprint hash;
+        for (const auto& file : files) hash.add(file.generic_string()).add(file_fingerprint(file));
+        return hash.str();
+    }
+
+    std::string lua_fingerprint(const std::filesystem::path& root, const std::filesystem::path& exclude)
+    {
+        namespace fs = std::filesystem;
+
+        std::error_code ec;
+        auto excluded = exclude.empty() ? fs::path{} : fs::weakly_canonical(exclude, ec);
+
+        std::vector<fs::path> files;
+        for (auto it = fs::recursive_directory_iterator{ root, fs::directory_options::skip_permission_denied, ec };
+             it != fs::recursive_directory_iterator{};
+             it.increment(ec))
+        {
+            if (ec) break;
+            const auto& path = it->path();
+            if (it->is_directory(ec))
+            {
+                auto name = path.filename().string();
+                if (name.starts_with(".") || name == "build" || (!excluded.empty() && fs::weakly_canonical(path, ec) == excluded))
+                    it.disable_recursion_pending();
+            }
+            else if (path.extension() == ".lua") files.emplace_back(path);
+        }
+        // directory iteration order is unspecified
+        std::sort(files.begin(), files.end());
+
+        // file hashes are kept for the lifetime of the process, a resident daemon only reads changed files
+        struct file_hash
+        {
+            std::uintmax_t size;
+            fs::file_time_type time;
+            std::string hash;
+        };
+        static std::mutex memo_mutex;
+        static std::map<fs::path, file_hash> memo;
+        std::lock_guard lock{ memo_mutex };
+
+        fingerprint hash;
+        for (const auto& file : files)
+        {
+            auto size = fs::file_size(file, ec);
+            auto time = fs::last_write_time(file, ec);
+            auto& entry = memo[file];
+            if (entry.hash.empty() || entry.size != size || entry.time != time) entry = file_hash{ size, time, fingerprint{}.add_file(file).str() };
+            hash.add(entry.hash);
+        }
+        return hash.str();
+    }
+
+    std::string read_file(const std::filesystem::path& path)
+    {
+        std::ifstream ifs{ path, std::ios::binary };
+        return { std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+    }
+
+    void write_file(const std::filesystem::path& path, std::string_view data)
+    {
+        auto tmp_path = path;
+        tmp_path += ".tmp" + std::to_string(std::random_device{}());
+        {
+            std::ofstream ofs{ tmp_path, std::ios::binary | std::ios::trunc };
+            if (!ofs) throw std::runtime_error{ "unable to write " + tmp_path.string() };
+            ofs.write(data.data(), static_cast<std::streamsize>(data.size()));
+        }
+        std::filesystem::rename(tmp_path, path);
+    }
+
+    std::string cmake_content(std::string_view data)
+    {
+        std::string content;
+        content.reserve(data.size());
+        while (!data.empty())
+        {
+            auto end = data.find('\n');
+            auto line = data.substr(0, end);
+            data.remove_prefix(end == std::string_view::npos ? data.size() : end + 1);
+
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            auto first = line.find_first_not_of(" \t");
+            if (first == std::string_view::npos || line[first] == '#') continue;
+            content.append(line).push_back('\n');
+        }
+        return content;
+    }
+
+    path_replacements directory_spellings(const std::filesystem::path& directory, const std::string& placeholder)
+    {
+        auto path = std::filesystem::absolute(directory).lexically_normal();
+        auto generic = path.generic_string();
+        while (generic.size() > 1 && generic.back() == '/') generic.pop_back();
+
+        path_replacements spellings{ { generic, placeholder } };
+        auto native = path.string();
+        while (native.size() > 1 && (native.back() == '/' || native.back() == '\\')) native.pop_back();
+        if (native != generic) spellings.emplace_back(native, placeholder);
+        return spellings;
+    }
+
+    void relocate(std::string& data, const path_replacements& replacements)
+    {
+        for (const auto& [from, to] : replacements)
+        {
+            if (from.empty()) continue;
+            std::size_t offset = 0;
+            while ((offset = data.find(from, offset)) != std::string::npos)
+            {
+                data.replace(offset, from.size(), to);
+                offset += to.size();
+            }
+        }
+    }
+
+    void relocate_files(const std::filesystem::path& path, const path_replacements& replacements)
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        if (fs::is_directory(path, ec))
+        {
+            for (const auto& entry : fs::directory_iterator{ path, ec }) relocate_files(entry.path(), replacements);
+            return;
+        }
+        // binaries (compiler id executables, objects) are kept as is
+        if (!fs::is_regular_file(path, ec) || fs::file_size(path, ec) > 1024 * 1024) return;
+
+        auto data = read_file(path);
+        if (data.find('\0') != std::string::npos) return;
+
+        auto relocated = data;
+        relocate(relocated, replacements);
+        if (relocated == data) return;
+
+        std::ofstream ofs{ path, std::ios::binary | std::ios::trunc };
+        ofs << relocated;
+    }
+
+    cache::cache(std::filesystem::path path)
+        : path_{ std::move(path) }
+    {
+        std::ifstream ifs{ path_ };
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            auto offset = line.find(' ');
+            if (offset == std::string::npos) continue;
+            entries_[line.substr(0, offset)] = line.substr(offset + 1);
+        }
+    }
+
+    std::string cache::get(const std::string& key) const
+    {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return {};
+        return it->second;
+    }
+
+    void cache::set(const std::string& key, std::string value) { entries_[key] = std::move(value); }
+
+    void cache::clear() { entries_.clear(); }
+
+    void cache::save() const
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(path_.parent_path(), ec);
+
+        std::string data;
+        for (const auto& [key, value] : entries_) data.append(key).append(" ").append(value).append("\n");
+        write_file(path_, data);
+    }
+} // xc
@@ -0,0 +1,260 @@
+#include <xc/command.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+
+namespace xc
+{
+    namespace
+    {
+        enum class flag
+        {
+            source,
+            build_directory,
+            generator,
+            entry,
+            option,
+            build,
+            target,
+            parallel,
+            config,
+            clean_first,
+            verbose,
+            version,
+            last_errors,
+            native
+        };
+
+        enum class arity
+        {
+            none,
+            value,
+            optional_number,
+            values // until the next flag
+        };
+
+        struct flag_spec
+        {
+            std::string_view spelling;
+            xc::flag id;
+            xc::arity arity;
+        };
+
+        constexpr std::array flag_specs{
+            flag_spec{ "-S", flag::source, arity::value },
+            flag_spec{ "-B", flag::build_directory, arity::value },
+            flag_spec{ "-G", flag::generator, arity::value },
+            flag_spec{ "-D", flag::entry, arity::value },
+            flag_spec{ "-A", flag::option, arity::value },
+            flag_spec{ "-T", flag::option, arity::value },
+            flag_spec{ "-U", flag::option, arity::value },
+            flag_spec{ "-C", flag::option, arity::value },
+            flag_spec{ "-P", flag::option, arity::value },
+            flag_spec{ "--preset", flag::option, arity::value },
+            flag_spec{ "--toolchain", flag::option, arity::value },
+            flag_spec{ "--install-prefix", flag::option, arity::value },
+            flag_spec{ "--build", flag::build, arity::value },
+            flag_spec{ "--target", flag::target, arity::values },
+            flag_spec{ "-t", flag::target, arity::values },
+            flag_spec{ "--parallel", flag::parallel, arity::optional_number },
+            flag_spec{ "-j", flag::parallel, arity::optional_number },
+            flag_spec{ "--config", flag::config, arity::value },
+            flag_spec{ "--clean-first", flag::clean_first, arity::none },
+            flag_spec{ "--verbose", flag::verbose, arity::none },
+            flag_spec{ "-v", flag::verbose, arity::none },
+            flag_spec{ "--version", flag::version, arity::none },
+            flag_spec{ "--last-errors", flag::last_errors, arity::none },
+            flag_spec{ "--severity", flag::option, arity::value },
+            flag_spec{ "--file", flag::option, arity::value },
+            flag_spec{ "--", flag::native, arity::none },
+        };
+
+        // perfect hash : the seed is searched at compile time so that every flag has its own slot
+        constexpr std::size_t flag_slots = 64;
+
+        constexpr std::uint32_t flag_hash(std::string_view flag, std::uint32_t seed)
+        {
+            for (char c : flag) seed = (seed ^ static_cast<unsigned char>(c)) * 16777619u;
+            return seed;
+        }
+
+        consteval std::uint32_t flag_seed()
+        {
+            for (std::uint32_t seed = 2166136261u;; ++seed)
+            {
+                std::array<bool, flag_slots> used{};
+                bool collision = false;
+                for (const auto& spec : flag_specs)
+                {
+                    auto slot = flag_hash(spec.spelling, seed) % flag_slots;
+                    collision = collision || used[slot];
+                    used[slot] = true;
+                }
+                if (!collision) return seed;
+            }
+        }
+
+        constexpr std::uint32_t seed = flag_seed();
+
+        consteval std::array<std::int8_t, flag_slots> make_flag_table()
+        {
+            std::array<std::int8_t, flag_slots> table{};
+            for (auto& slot : table) slot = -1;
+            for (std::size_t i = 0; i < flag_specs.size(); ++i) table[flag_hash(flag_specs[i].spelling, seed) % flag_slots] = static_cast<std::int8_t>(i);
+            return table;
+        }
+
+        constexpr auto flag_table = make_flag_table();
+
+        const flag_spec* find_flag(std::string_view spelling)
+        {
+            auto index = flag_table[flag_hash(spelling, seed) % flag_slots];
+            if (index < 0 || flag_specs[index].spelling != spelling) return nullptr;
+            return &flag_specs[index];
+        }
+
+        command::entry parse_entry(std::string_view data)
+        {
+            auto equal = data.find('=');
+            if (equal == std::string_view::npos || equal == 0) throw std::logic_error{ "invalid cache entry " + std::string{ data } };
+
+            command::entry entry{ data.substr(0, equal), {}, data.substr(equal + 1) };
+            if (auto colon = entry.name.find(':'); colon != std::string_view::npos)
+            {
+                entry.type = entry.name.substr(colon + 1);
+                entry.name = entry.name.substr(0, colon);
+            }
+            if (entry.name.starts_with("CMAKE_")) entry.kind = xc::parameter_type::user_cmake;
+            else if (entry.name.starts_with("XC_")) entry.kind = xc::parameter_type::user_xc;
+            return entry;
+        }
+
+        bool is_number(std::string_view data)
+        {
+            return !data.empty() && data.find_first_not_of("0123456789") == std::string_view::npos;
+        }
+    } // namespace
+
+    std::string_view to_string(xc::command_mode mode)
+    {
+        switch (mode)
+        {
+        case command_mode::run: return "run";
+        case command_mode::version: return "version";
+        case command_mode::try_compile: return "try_compile";
+        case command_mode::generate: return "generate";
+        case command_mode::build: return "build";
+        case command_mode::last_errors: return "last_errors";
+        case command_mode::unknown: break;
+        }
+        return "unknown";
+    }
+
+    const command::entry* command::find(std::string_view name) const
+    {
+        // a later definition overrides the previous ones
+        for (auto it = entries.end(); it != entries.begin();)
+        {
+            if ((--it)->name == name) return it;
+        }
+        return nullptr;
+    }
+
+    std::string_view command::value(std::string_view name, std::string_view default_value) const
+    {
+        auto entry = find(name);
+        return entry ? entry->value : default_value;
+    }
+
+    command parse_command(std::span<const std::string> args)
+    {
+        xc::command command;
+        bool version = false;
+        bool last_errors = false;
+        bool build = false;
+
+        for (std::size_t i = 0; i < args.size(); ++i)
+        {
+            std::string_view arg = args[i];
+            if (arg.size() < 2 || arg[0] != '-')
+            {
+                if (command.positional.empty()) command.positional = arg;
+                continue;
+            }
+
+            // -D<entry>, -j8, --parallel=8
+            std::string_view attached;
+            const auto* spec = find_flag(arg);
+            if (!spec)
+            {
+                auto split = arg[1] == '-' ? arg.find('=') : std::size_t{ 2 };
+                if (split != std::string_view::npos && split < arg.size()) spec = find_flag(arg.substr(0, split));
+                if (spec && spec->arity != arity::none) attached = arg.substr(split + (arg[1] == '-' ? 1 : 0));
+                else
+                {
+                    command.options.push_back({ arg, {} });
+                    continue;
+                }
+            }
+
+            std::string_view value = attached;
+            switch (spec->arity)
+            {
+            case arity::none: break;
+            case arity::value:
+                if (value.empty())
+                {
+                    if (i + 1 >= args.size()) throw std::logic_error{ "missing value of " + std::string{ arg } };
+                    value = args[++i];
+                }
+                break;
+            case arity::optional_number:
+                if (value.empty() && i + 1 < args.size() && is_number(args[i + 1])) value = args[++i];
+                break;
+            case arity::values:
+                if (!value.empty()) command.targets.push_back(value);
+                while (i + 1 < args.size() && !args[i + 1].starts_with("-")) command.targets.push_back(args[++i]);
+                break;
+            }
+
+            switch (spec->id)
+            {
+            case flag::source: command.source_directory = value; break;
+            case flag::build_directory: command.build_directory = value; break;
+            case flag::generator: command.generator = value; break;
+            case flag::entry:
+            {
+                auto entry = parse_entry(value);
+                if (entry.name == "CMAKE_BUILD_TYPE") command.build_type = entry.value;
+                command.entries.push_back(entry);
+                break;
+            }
+            case flag::option: command.options.push_back({ spec->spelling, value }); break;
+            case flag::build:
+                build = true;
+                command.build_directory = value;
+                break;
+            case flag::target: break;
+            case flag::parallel: std::from_chars(value.data(), value.data() + value.size(), command.parallel); break;
+            case flag::config: command.build_type = value; break;
+            case flag::clean_first: command.clean_first = true; break;
+            case flag::verbose: command.verbose = true; break;
+            case flag::version: version = true; break;
+            case flag::last_errors: last_errors = true; break;
+            // the remaining arguments are for the native build tool
+            case flag::native: i = args.size(); break;
+            }
+        }
+
+        if (args.empty()) command.mode = command_mode::run;
+        else if (version) command.mode = command_mode::version;
+        else if (last_errors) command.mode = command_mode::last_errors;
+        else if (command.find("CMAKE_TRY_COMPILE_TARGET_TYPE")) command.mode = command_mode::try_compile;
+        else if (!command.generator.empty()) command.mode = command_mode::generate;
+        else if (build) command.mode = command_mode::build;
+        else command.mode = command_mode::unknown;
+        return command;
+    }
+} // xc
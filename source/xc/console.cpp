@@ -0,0 +1,113 @@
+#include <xc/console.hpp>
+
+#include <cstdlib>
+
+namespace xc
+{
+    console& console::instance()
+    {
+        static console instance;
+        return instance;
+    }
+
+    console::console()
+    {
+        if (const char* path = std::getenv("XC_LOG_FILE")) tee(path);
+        thread_ = std::thread{ [this] { process(); } };
+    }
+
+    console::~console()
+    {
+        {
+            std::lock_guard lock{ mutex_ };
+            stop_ = true;
+        }
+        write_condition_.notify_one();
+        thread_.join();
+        if (tee_) std::fclose(tee_);
+    }
+
+    void console::write(std::string_view data)
+    {
+        std::lock_guard lock{ mutex_ };
+        pending_.append(data);
+        notify();
+    }
+
+    void console::write(std::initializer_list<std::string_view> parts)
+    {
+        std::lock_guard lock{ mutex_ };
+        for (auto part : parts) pending_.append(part);
+        notify();
+    }
+
+    void console::flush()
+    {
+        std::unique_lock lock{ mutex_ };
+        auto sequence = pending_sequence_;
+        flush_requested_ = true;
+        write_condition_.notify_one();
+        flush_condition_.wait(lock, [this, sequence] { return written_sequence_ >= sequence || stop_; });
+    }
+
+    void console::tee(const std::filesystem::path& path)
+    {
+        std::lock_guard lock{ file_mutex_ };
+        if (tee_) std::fclose(tee_);
+        tee_ = std::fopen(path.string().c_str(), "ab");
+    }
+
+    void console::redirect(std::function<void(std::string_view)> sink)
+    {
+        flush();
+        std::lock_guard lock{ file_mutex_ };
+        sink_ = std::move(sink);
+    }
+
+    void console::notify()
+    {
+        ++pending_sequence_;
+        // the writer wakes up by itself after batch_delay, only large batches are signaled
+        if (pending_.size() >= batch_size) write_condition_.notify_one();
+    }
+
+    void console::process()
+    {
+        std::unique_lock lock{ mutex_ };
+        while (true)
+        {
+            write_condition_.wait_for(lock, batch_delay, [this] { return stop_ || flush_requested_ || pending_.size() >= batch_size; });
+
+            auto sequence = pending_sequence_;
+            flush_requested_ = false;
+            bool stop = stop_;
+            if (!pending_.empty())
+            {
+                writing_.swap(pending_);
+                lock.unlock();
+
+                {
+                    std::lock_guard file_lock{ file_mutex_ };
+                    if (sink_) sink_(writing_);
+                    else
+                    {
+                        std::fwrite(writing_.data(), 1, writing_.size(), stdout);
+                        std::fflush(stdout);
+                    }
+                    if (tee_)
+                    {
+                        std::fwrite(writing_.data(), 1, writing_.size(), tee_);
+                        std::fflush(tee_);
+                    }
+                }
+                // keep the capacity for the next batch
+                writing_.clear();
+                lock.lock();
+            }
+            written_sequence_ = sequence;
+            flush_condition_.notify_all();
+
+            if (stop && pending_.empty()) return;
+        }
+    }
+} // xc
@@ -0,0 +1,285 @@
+#include <xc/daemon.hpp>
+
+#include <xc/cache.hpp>
+#include <xc/command.hpp>
+#include <xc/console.hpp>
+#include <xc/progress.hpp>
+#include <xc/supervisor.hpp>
+#include <xc/tool.hpp>
+#include <xc/utility.hpp>
+#include <xc/xcmake.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace xc::daemon
+{
+    std::filesystem::path socket_path(const std::vector<std::string>& args)
+    {
+        std::string_view build_directory;
+        try
+        {
+            build_directory = xc::parse_command(args).build_directory;
+        }
+        catch (const std::exception&)
+        {
+            // the invalid command line is reported by the daemon
+        }
+
+        std::error_code ec;
+        if (!build_directory.empty())
+        {
+            auto path = std::filesystem::absolute(build_directory, ec) / ".xc" / "daemon.sock";
+            // sun_path is limited to about 100 chars
+            if (path.string().size() < 100) return path;
+            return xc::cache_directory() / ("daemon-" + xc::fingerprint{}.add(path.string()).str() + ".sock");
+        }
+        return xc::cache_directory() / "daemon.sock";
+    }
+
+#if defined(_WIN32)
+    std::optional<int> forward(const std::string&, const std::vector<std::string>&) { return std::nullopt; }
+
+    int serve(const std::string&, const std::filesystem::path&, std::chrono::seconds)
+    {
+        std::fputs("xc daemon is not supported on this platform\n", stderr);
+        return 1;
+    }
+#else
+    namespace
+    {
+        enum class frame : char
+        {
+            output = 'o',
+            exit = 'x'
+        };
+
+        bool write_all(int fd, const void* data, std::size_t size)
+        {
+            auto bytes = static_cast<const char*>(data);
+            while (size > 0)
+            {
+                auto n = ::send(fd, bytes, size, MSG_NOSIGNAL);
+                if (n <= 0) return false;
+                bytes += n;
+                size -= static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+
+        bool read_all(int fd, void* data, std::size_t size)
+        {
+            auto bytes = static_cast<char*>(data);
+            while (size > 0)
+            {
+                auto n = ::recv(fd, bytes, size, 0);
+                if (n <= 0) return false;
+                bytes += n;
+                size -= static_cast<std::size_t>(n);
+            }
+            return true;
+        }
+
+        bool write_string(int fd, std::string_view data)
+        {
+            auto size = static_cast<std::uint32_t>(data.size());
+            return write_all(fd, &size, sizeof(size)) && write_all(fd, data.data(), data.size());
+        }
+
+        bool read_string(int fd, std::string& data)
+        {
+            std::uint32_t size = 0;
+            if (!read_all(fd, &size, sizeof(size))) return false;
+            data.resize(size);
+            return read_all(fd, data.data(), size);
+        }
+
+        bool write_strings(int fd, const std::vector<std::string>& data)
+        {
+            auto count = static_cast<std::uint32_t>(data.size());
+            if (!write_all(fd, &count, sizeof(count))) return false;
+            for (const auto& item : data)
+            {
+                if (!write_string(fd, item)) return false;
+            }
+            return true;
+        }
+
+        bool read_strings(int fd, std::vector<std::string>& data)
+        {
+            std::uint32_t count = 0;
+            if (!read_all(fd, &count, sizeof(count))) return false;
+            data.resize(count);
+            for (auto& item : data)
+            {
+                if (!read_string(fd, item)) return false;
+            }
+            return true;
+        }
+
+        bool write_frame(int fd, frame type, std::string_view data)
+        {
+            return write_all(fd, &type, sizeof(type)) && write_string(fd, data);
+        }
+
+        sockaddr_un address(const std::filesystem::path& path)
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            return address;
+        }
+
+        int connect(const std::filesystem::path& path)
+        {
+            int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+            if (fd < 0) return -1;
+            auto addr = address(path);
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+            {
+                ::close(fd);
+                return -1;
+            }
+            return fd;
+        }
+
+        std::optional<int> handle(int fd, const std::string& program)
+        {
+            std::string cwd;
+            std::vector<std::string> args;
+            std::vector<std::string> environment;
+            if (!read_string(fd, cwd) || !read_strings(fd, args) || !read_strings(fd, environment)) return std::nullopt;
+
+            // requests are served one at a time, the process state is the one of the client
+            std::error_code ec;
+            std::filesystem::current_path(cwd, ec);
+            ::clearenv();
+            for (auto& variable : environment) ::putenv(variable.data());
+
+            auto& console = xc::console::instance();
+            // a client which disconnected was cancelled, its build is stopped
+            console.redirect([fd](std::string_view data) {
+                if (!write_frame(fd, frame::output, data)) xc::supervisor::instance().terminate();
+            });
+            int exit_code = 0;
+            try
+            {
+                xc::xcmake xcmake{ program, std::move(args) };
+                exit_code = xcmake.process();
+            }
+            catch (const std::exception& e)
+            {
+                console.write({ "xc exception: ", e.what() });
+                exit_code = 1;
+            }
+            console.redirect(nullptr);
+
+            // environment strings are referenced by environ until the next request
+            static std::vector<std::string> request_environment;
+            request_environment = std::move(environment);
+            return exit_code;
+        }
+    } // namespace
+
+    std::optional<int> forward(const std::string& program, const std::vector<std::string>& args)
+    {
+        auto path = socket_path(args);
+        int fd = connect(path);
+        if (fd < 0)
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+            if (!xc::spawn_detached({ xc::current_executable(program).string(), "--xc-daemon", path.string() })) return std::nullopt;
+            for (int i = 0; i < 100 && fd < 0; ++i)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds{ 20 });
+                fd = connect(path);
+            }
+            if (fd < 0) return std::nullopt;
+        }
+
+        std::vector<std::string> environment;
+        for (char** variable = environ; variable && *variable; ++variable) environment.emplace_back(*variable);
+        // the daemon does not write to the terminal of the client, the progress mode is resolved here
+        environment.emplace_back(xc::detect_progress_mode() == xc::progress_mode::line ? "XC_PROGRESS=line" : "XC_PROGRESS=full");
+        std::error_code ec;
+        if (!write_string(fd, std::filesystem::current_path(ec).string()) || !write_strings(fd, args) || !write_strings(fd, environment))
+        {
+            ::close(fd);
+            return std::nullopt;
+        }
+
+        std::optional<int> exit_code;
+        frame type;
+        std::string data;
+        while (read_all(fd, &type, sizeof(type)) && read_string(fd, data))
+        {
+            if (type == frame::output) std::fwrite(data.data(), 1, data.size(), stdout);
+            else if (type == frame::exit && data.size() == sizeof(int))
+            {
+                int value = 0;
+                std::memcpy(&value, data.data(), sizeof(value));
+                exit_code = value;
+                break;
+            }
+        }
+        std::fflush(stdout);
+        ::close(fd);
+        // a daemon lost in the middle of a request already produced output, it is not replayed
+        return exit_code ? exit_code : std::optional<int>{ 1 };
+    }
+
+    int serve(const std::string& program, const std::filesystem::path& socket_path, std::chrono::seconds idle_timeout)
+    {
+        // another daemon already serves this socket
+        if (int fd = connect(socket_path); fd >= 0)
+        {
+            ::close(fd);
+            return 0;
+        }
+
+        int server = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (server < 0) return 1;
+        ::unlink(socket_path.c_str());
+        auto addr = address(socket_path);
+        if (::bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(server, 16) != 0)
+        {
+            ::close(server);
+            return 1;
+        }
+
+        while (true)
+        {
+            pollfd poll_fd{ server, POLLIN, 0 };
+            int ready = ::poll(&poll_fd, 1, static_cast<int>(std::chrono::milliseconds{ idle_timeout }.count()));
+            if (ready == 0) break;
+            if (ready < 0) continue;
+
+            int client = ::accept4(server, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client < 0) continue;
+            if (auto exit_code = handle(client, program))
+            {
+                write_frame(client, frame::exit, { reinterpret_cast<const char*>(&*exit_code), sizeof(int) });
+            }
+            ::close(client);
+            // the daemon itself was asked to stop
+            if (xc::supervisor::instance().signal()) break;
+        }
+
+        ::close(server);
+        ::unlink(socket_path.c_str());
+        return 0;
+    }
+#endif
+} // xc::daemon
@@ -0,0 +1,151 @@
+#include <xc/diagnostic.hpp>
+
+#include <array>
+#include <utility>
+
+namespace xc
+{
+    namespace
+    {
+        constexpr std::array<std::pair<std::string_view, xc::severity>, 5> keywords{ {
+            { "fatal error", xc::severity::fatal },
+            { "error", xc::severity::error },
+            { "warning", xc::severity::warning },
+            { "Command line warning", xc::severity::warning },
+            { "note", xc::severity::note },
+        } };
+
+        bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+        // parse a number at offset, return the offset past it or npos
+        std::size_t parse_number(std::string_view line, std::size_t offset, int& value)
+        {
+            auto begin = offset;
+            value = 0;
+            while (offset < line.size() && is_digit(line[offset])) value = value * 10 + (line[offset++] - '0');
+            return offset == begin ? std::string_view::npos : offset;
+        }
+
+        // parse the location following a file name, return the offset of the ':' ending it or npos
+        std::size_t parse_location(std::string_view line, std::size_t offset, xc::diagnostic& diagnostic)
+        {
+            if (line[offset] == '(')
+            {
+                offset = parse_number(line, offset + 1, diagnostic.line);
+                if (offset == std::string_view::npos) return offset;
+                if (offset < line.size() && line[offset] == ',')
+                {
+                    offset = parse_number(line, offset + 1, diagnostic.column);
+                    if (offset == std::string_view::npos) return offset;
+                }
+                if (offset >= line.size() || line[offset] != ')') return std::string_view::npos;
+                ++offset;
+                if (offset < line.size() && line[offset] == ' ') ++offset;
+            }
+            else
+            {
+                offset = parse_number(line, offset + 1, diagnostic.line);
+                if (offset == std::string_view::npos) return offset;
+                if (offset + 1 < line.size() && line[offset] == ':' && is_digit(line[offset + 1]))
+                    offset = parse_number(line, offset + 1, diagnostic.column);
+            }
+            if (offset >= line.size() || line[offset] != ':') return std::string_view::npos;
+            return offset;
+        }
+
+        // parse "severity: " or "severity CODE: " after the location separator
+        bool parse_severity(std::string_view line, std::size_t separator, xc::diagnostic& diagnostic)
+        {
+            auto label_begin = separator == std::string_view::npos ? 0 : separator;
+            auto offset = separator == std::string_view::npos ? 0 : separator + 1;
+            while (offset < line.size() && line[offset] == ' ') ++offset;
+            auto rest = line.substr(offset);
+
+            for (const auto& [keyword, severity] : keywords)
+            {
+                if (!rest.starts_with(keyword)) continue;
+                auto end = offset + keyword.size();
+
+                if (end < line.size() && line[end] == ' ')
+                {
+                    // msvc code
+                    auto code_begin = end + 1;
+                    auto code_end = code_begin;
+                    while (code_end < line.size() && line[code_end] != ':' && line[code_end] != ' ') ++code_end;
+                    if (code_end == code_begin || code_end >= line.size() || line[code_end] != ':') continue;
+                    diagnostic.code = line.substr(code_begin, code_end - code_begin);
+                    diagnostic.message = line.substr(code_end + 1);
+                }
+                else if (end < line.size() && line[end] == ':') diagnostic.message = line.substr(end + 1);
+                else continue;
+
+                diagnostic.severity = severity;
+                diagnostic.label = line.substr(label_begin, end - label_begin);
+                while (!diagnostic.message.empty() && diagnostic.message.front() == ' ') diagnostic.message.remove_prefix(1);
+
+                // gcc / clang flag
+                if (diagnostic.code.empty() && diagnostic.message.ends_with(']'))
+                {
+                    auto flag = diagnostic.message.rfind(" [-W");
+                    if (flag != std::string_view::npos)
+                    {
+                        diagnostic.code = diagnostic.message.substr(flag + 2, diagnostic.message.size() - flag - 3);
+                        diagnostic.message = diagnostic.message.substr(0, flag);
+                    }
+                }
+                return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    std::optional<xc::diagnostic> parse_diagnostic(std::string_view line)
+    {
+        // location-less diagnostics : "error: message"
+        if (line.starts_with("error:") || line.starts_with("warning:"))
+        {
+            xc::diagnostic diagnostic;
+            if (parse_severity(line, std::string_view::npos, diagnostic)) return diagnostic;
+        }
+
+        std::size_t offset = 0;
+        while ((offset = line.find_first_of(":(", offset)) != std::string_view::npos)
+        {
+            // drive letter
+            if (offset == 1 && line[offset] == ':' && offset + 1 < line.size() && (line[2] == '\\' || line[2] == '/'))
+            {
+                ++offset;
+                continue;
+            }
+
+            xc::diagnostic diagnostic;
+            auto separator = offset + 1 < line.size() && is_digit(line[offset + 1]) ? parse_location(line, offset, diagnostic) : std::string_view::npos;
+            // tool diagnostics without location : "LINK : fatal error LNK1104: message"
+            if (separator == std::string_view::npos && line[offset] == ':') separator = offset;
+
+            if (separator != std::string_view::npos && parse_severity(line, separator, diagnostic))
+            {
+                auto file = line.substr(0, offset);
+                while (!file.empty() && file.back() == ' ') file.remove_suffix(1);
+                diagnostic.file = file;
+                return diagnostic;
+            }
+            ++offset;
+        }
+        return std::nullopt;
+    }
+
+    bool is_compiler_record(const xc::diagnostic& diagnostic) { return !diagnostic.file.empty(); }
+
+    std::string_view to_string(xc::severity severity)
+    {
+        switch (severity)
+        {
+        case xc::severity::note: return "note";
+        case xc::severity::warning: return "warning";
+        case xc::severity::error: return "error";
+        case xc::severity::fatal: return "fatal error";
+        }
+        return {};
+    }
+} // xc
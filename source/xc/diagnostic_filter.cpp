@@ -0,0 +1,126 @@
+#include <xc/diagnostic_filter.hpp>
+
+#include <algorithm>
+#include <array>
+
+namespace xc
+{
+    namespace
+    {
+        // gcc prints the context of a diagnostic before it
+        bool is_context(std::string_view line)
+        {
+            constexpr std::array markers{ ": In instantiation of", ": In substitution of", ": In function", ": In member function", ": In static member function",
+                                          ": In constructor", ": In destructor", ": In lambda function", "required from", "required by substitution" };
+            if (line.starts_with("In file included from")) return true;
+            // "                 from b.cpp:1:" continues the include stack
+            auto text = line.substr(std::min(line.find_first_not_of(' '), line.size()));
+            if (text.size() < line.size() && text.starts_with("from ")) return true;
+            for (auto marker : markers)
+            {
+                if (line.find(marker) != std::string_view::npos) return true;
+            }
+            return false;
+        }
+
+        std::string collapsed_line(std::size_t count) { return "... " + std::to_string(count) + " lines collapsed"; }
+    } // namespace
+
+    diagnostic_filter::diagnostic_filter(std::size_t max_notes)
+        : max_notes_{ max_notes }
+    {}
+
+    void diagnostic_filter::add(std::string_view line, const std::optional<xc::diagnostic>& diagnostic, emit_callback emit)
+    {
+        if (max_notes_ == 0)
+        {
+            emit(line, diagnostic);
+            return;
+        }
+
+        if (diagnostic && diagnostic->severity != xc::severity::note)
+        {
+            // the buffered context belongs to the new diagnostic
+            end_group(emit);
+            std::string key{ diagnostic->file };
+            key.append(":").append(std::to_string(diagnostic->line)).append(":").append(std::to_string(diagnostic->column));
+            key.append(":").append(xc::to_string(diagnostic->severity)).append(":").append(diagnostic->message);
+
+            in_group_ = true;
+            group_printed_ = primaries_.insert(std::move(key)).second;
+            entry_printed_ = group_printed_;
+            group_notes_ = 0;
+            notes_.clear();
+            flush_context(group_printed_, emit);
+            if (group_printed_) emit(line, diagnostic);
+            else ++collapsed_;
+        }
+        else if (diagnostic)
+        {
+            // a note without diagnostic is printed as is
+            bool print = !in_group_;
+            if (in_group_ && group_printed_)
+            {
+                print = group_notes_ < max_notes_ && notes_.emplace(diagnostic->message).second;
+                if (print) ++group_notes_;
+            }
+            entry_printed_ = print;
+            flush_context(print, emit);
+            if (print) emit(line, diagnostic);
+            else
+            {
+                ++collapsed_;
+                if (group_printed_) ++group_collapsed_;
+            }
+        }
+        else if (is_context(line)) context_.emplace_back(line);
+        // source lines and other output follow the last diagnostic
+        else if (!in_group_ || entry_printed_)
+        {
+            flush_context(true, emit);
+            emit(line, diagnostic);
+        }
+        else
+        {
+            flush_context(false, emit);
+            ++collapsed_;
+            if (group_printed_) ++group_collapsed_;
+        }
+    }
+
+    void diagnostic_filter::close(emit_callback emit)
+    {
+        end_group(emit);
+        flush_context(true, emit);
+    }
+
+    void diagnostic_filter::end_group(emit_callback emit)
+    {
+        if (in_group_ && group_collapsed_ > 0) emit(collapsed_line(group_collapsed_), std::nullopt);
+        in_group_ = false;
+        group_collapsed_ = 0;
+    }
+
+    void diagnostic_filter::flush_context(bool print, emit_callback emit)
+    {
+        if (!print)
+        {
+            collapsed_ += context_.size();
+            if (in_group_ && group_printed_) group_collapsed_ += context_.size();
+        }
+        // a long instantiation chain keeps its first lines and the one closest to the diagnostic
+        else if (context_.size() > max_notes_ && max_notes_ > 1)
+        {
+            for (std::size_t i = 0; i < max_notes_ - 1; ++i) emit(context_[i], std::nullopt);
+            auto count = context_.size() - max_notes_;
+            emit(collapsed_line(count), std::nullopt);
+            emit(context_.back(), std::nullopt);
+            collapsed_ += count;
+        }
+        else
+        {
+            for (const auto& line : context_) emit(line, std::nullopt);
+        }
+        context_.clear();
+    }
+} // xc
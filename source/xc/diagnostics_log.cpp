@@ -0,0 +1,197 @@
+#include <xc/diagnostics_log.hpp>
+
+#include <xc/cache.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace xc
+{
+    namespace
+    {
+        constexpr std::string_view magic{ "XCDL\x01", 5 };
+
+        enum class record : std::uint8_t
+        {
+            build = 1,
+            diagnostic = 2
+        };
+
+        void put(std::string& data, std::uint32_t value) { data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+        void put(std::string& data, std::int64_t value) { data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+        void put(std::string& data, std::string_view value)
+        {
+            put(data, static_cast<std::uint32_t>(value.size()));
+            data.append(value);
+        }
+
+        // record kind, payload size, payload
+        void put_record(std::string& data, record kind, const std::string& payload)
+        {
+            data.push_back(static_cast<char>(kind));
+            put(data, static_cast<std::uint32_t>(payload.size()));
+            data.append(payload);
+        }
+
+        // bounds checked reads, a truncated record ends the reading
+        struct reader
+        {
+            std::string_view data;
+            bool failed{ false };
+
+            template<class T>
+            T get()
+            {
+                T value{};
+                if (data.size() < sizeof(T)) failed = true;
+                else
+                {
+                    std::memcpy(&value, data.data(), sizeof(T));
+                    data.remove_prefix(sizeof(T));
+                }
+                return value;
+            }
+
+            std::string_view get_string()
+            {
+                auto size = get<std::uint32_t>();
+                if (failed || data.size() < size)
+                {
+                    failed = true;
+                    return {};
+                }
+                auto value = data.substr(0, size);
+                data.remove_prefix(size);
+                return value;
+            }
+        };
+
+        // calls visit(kind, offset, payload) for every complete record
+        template<class Visit>
+        void scan(std::string_view data, Visit visit)
+        {
+            if (!data.starts_with(magic)) return;
+            reader input{ data.substr(magic.size()) };
+            while (!input.data.empty())
+            {
+                auto offset = data.size() - input.data.size();
+                auto kind = static_cast<record>(input.get<std::uint8_t>());
+                auto payload = input.get_string();
+                if (input.failed) return;
+                visit(kind, offset, payload);
+            }
+        }
+    } // namespace
+
+    void diagnostics_writer::add(const xc::diagnostic& diagnostic, std::string_view target)
+    {
+        // the summary lines of the build tool are not recorded
+        if (!xc::is_compiler_record(diagnostic)) return;
+        std::string payload;
+        payload.push_back(static_cast<char>(diagnostic.severity));
+        put(payload, static_cast<std::uint32_t>(diagnostic.line));
+        put(payload, static_cast<std::uint32_t>(diagnostic.column));
+        put(payload, diagnostic.file);
+        put(payload, target);
+        put(payload, diagnostic.code);
+        put(payload, diagnostic.message);
+        put_record(records_, record::diagnostic, payload);
+    }
+
+    void diagnostics_writer::save(const std::filesystem::path& path, std::string_view mode, std::string_view targets, int exit_code, std::size_t max_builds) const
+    {
+        std::string payload;
+        put(payload, static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()));
+        put(payload, static_cast<std::uint32_t>(exit_code));
+        put(payload, mode);
+        put(payload, targets);
+        std::string build;
+        put_record(build, record::build, payload);
+        build.append(records_);
+
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+        auto data = xc::read_file(path);
+        std::vector<std::size_t> builds;
+        std::size_t end = magic.size();
+        scan(data, [&](record kind, std::size_t offset, std::string_view payload) {
+            if (kind == record::build) builds.push_back(offset);
+            end = payload.data() + payload.size() - data.data();
+        });
+
+        // full, unreadable or truncated log : rewritten with the last builds
+        if (!data.starts_with(magic) || end != data.size() || builds.size() + 1 > max_builds)
+        {
+            auto first = builds.size() + 1 > max_builds ? builds.size() + 1 - max_builds : 0;
+            std::string content{ magic };
+            if (first < builds.size()) content.append(std::string_view{ data }.substr(builds[first], end - builds[first]));
+            if (max_builds > 0) content.append(build);
+            xc::write_file(path, content);
+            return;
+        }
+        std::ofstream ofs{ path, std::ios::binary | std::ios::app };
+        ofs.write(build.data(), static_cast<std::streamsize>(build.size()));
+    }
+
+    diagnostics_log::diagnostics_log(const std::filesystem::path& path)
+    {
+#if defined(_WIN32)
+        buffer_ = xc::read_file(path);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#else
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return;
+        struct stat status
+        {};
+        if (::fstat(fd, &status) == 0 && status.st_size > 0)
+        {
+            void* mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED)
+            {
+                data_ = static_cast<const char*>(mapping);
+                size_ = static_cast<std::size_t>(status.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+
+        scan({ data_, size_ }, [this](record kind, std::size_t, std::string_view payload) {
+            reader input{ payload };
+            if (kind == record::build)
+            {
+                auto& build = builds_.emplace_back();
+                build.time = input.get<std::int64_t>();
+                build.exit_code = static_cast<int>(input.get<std::uint32_t>());
+                build.mode = input.get_string();
+                build.targets = input.get_string();
+            }
+            else if (kind == record::diagnostic && !builds_.empty())
+            {
+                auto& diagnostic = builds_.back().diagnostics.emplace_back();
+                diagnostic.severity = static_cast<xc::severity>(input.get<std::uint8_t>());
+                diagnostic.line = static_cast<int>(input.get<std::uint32_t>());
+                diagnostic.column = static_cast<int>(input.get<std::uint32_t>());
+                diagnostic.file = input.get_string();
+                diagnostic.target = input.get_string();
+                diagnostic.code = input.get_string();
+                diagnostic.message = input.get_string();
+            }
+        });
+    }
+
+    diagnostics_log::~diagnostics_log()
+    {
+#if !defined(_WIN32)
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+} // xc
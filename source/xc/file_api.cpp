@@ -0,0 +1,265 @@
+#include <xc/file_api.hpp>
+
+#include <xc/cache.hpp>
+#include <xc/utility.hpp>
+
+#include <fmt/chrono.h>
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <regex>
+#include <set>
+#include <string_view>
+#include <vector>
+
+namespace xc
+{
+    namespace
+    {
+        namespace fs = std::filesystem;
+
+        fs::path directory_path(const fs::path& directory)
+        {
+            auto path = fs::absolute(directory).lexically_normal();
+            if (!path.has_filename()) path = path.parent_path();
+            return path;
+        }
+
+        // paths inside the base directory are relative, as written by cmake
+        std::string json_path(const std::string& path, const fs::path& base)
+        {
+            auto relative = fs::path{ path }.lexically_normal().lexically_relative(base);
+            if (relative.empty() || *relative.begin() == "..") return xc::json_escape(fs::path{ path }.generic_string());
+            return xc::json_escape(relative.generic_string());
+        }
+
+        template<class Range, class F>
+        std::string json_array(const Range& items, F&& format)
+        {
+            std::string array = "[";
+            for (const auto& item : items)
+            {
+                if (array.size() > 1) array += ',';
+                array += format(item);
+            }
+            return array + "]";
+        }
+
+        std::string json_indexes(const std::vector<std::size_t>& indexes)
+        {
+            return json_array(indexes, [](std::size_t index) { return std::to_string(index); });
+        }
+
+        std::string_view cmake_language(std::string_view sourcekind)
+        {
+            if (sourcekind == "cc") return "C";
+            if (sourcekind == "mm") return "OBJC";
+            if (sourcekind == "mxx") return "OBJCXX";
+            if (sourcekind == "as") return "ASM";
+            if (sourcekind == "cu") return "CUDA";
+            return "CXX";
+        }
+
+        std::string_view cmake_type(std::string_view kind)
+        {
+            if (kind == "binary") return "EXECUTABLE";
+            if (kind == "static") return "STATIC_LIBRARY";
+            if (kind == "shared") return "SHARED_LIBRARY";
+            if (kind == "object") return "OBJECT_LIBRARY";
+            return "UTILITY";
+        }
+
+        // -std=c++20, -std=gnu11, /std:c++latest
+        std::string language_standard(const std::vector<std::string>& flags)
+        {
+            for (const auto& flag : flags)
+            {
+                if (!flag.starts_with("-std=") && !flag.starts_with("/std:") && !flag.starts_with("-std:")) continue;
+                auto standard = flag.substr(5);
+                for (std::string_view prefix : { "gnu++", "c++", "gnu", "c" })
+                {
+                    if (standard.starts_with(prefix)) return standard.substr(prefix.size());
+                }
+            }
+            return {};
+        }
+
+        std::string command_fragment(const std::vector<std::string>& flags)
+        {
+            std::string fragment;
+            for (const auto& flag : flags)
+            {
+                if (!fragment.empty()) fragment += ' ';
+                fragment += flag.find(' ') == std::string::npos ? flag : "\"" + flag + "\"";
+            }
+            return fragment;
+        }
+
+        // reply objects are named after their content, as cmake does
+        std::string write_object(const fs::path& reply, const std::string& prefix, const std::string& content)
+        {
+            auto name = fmt::format("{}-{}.json", prefix, xc::fingerprint{}.add(content).str());
+            xc::write_file(reply / name, content);
+            return name;
+        }
+
+        std::string target_object(const xc::project_target& target, const std::string& id, const std::string& directory_id, const fs::path& source, const fs::path& build)
+        {
+            std::vector<std::string> sources;
+            std::vector<std::string> compile_groups;
+            std::vector<std::size_t> source_indexes;
+            for (const auto& group : target.groups)
+            {
+                std::vector<std::size_t> indexes;
+                for (const auto& file : group.sources)
+                {
+                    indexes.push_back(sources.size());
+                    sources.push_back(fmt::format(R"({{"path":"{}","compileGroupIndex":{},"sourceGroupIndex":0}})", json_path(file, source), compile_groups.size()));
+                }
+                source_indexes.insert(source_indexes.end(), indexes.begin(), indexes.end());
+
+                std::vector<std::string> includes;
+                for (const auto& path : group.includes) includes.push_back(fmt::format(R"({{"path":"{}"}})", xc::json_escape(path)));
+                for (const auto& path : group.system_includes) includes.push_back(fmt::format(R"({{"path":"{}","isSystem":true}})", xc::json_escape(path)));
+
+                auto compile_group = fmt::format(R"({{"language":"{}","sourceIndexes":{},"includes":{},"defines":{})",
+                                                 cmake_language(group.kind),
+                                                 json_indexes(indexes),
+                                                 json_array(includes, [](const auto& include) { return include; }),
+                                                 json_array(group.defines, [](const auto& define) { return fmt::format(R"({{"define":"{}"}})", xc::json_escape(define)); }));
+                if (!group.flags.empty()) compile_group += fmt::format(R"(,"compileCommandFragments":[{{"fragment":"{}"}}])", xc::json_escape(command_fragment(group.flags)));
+                if (auto standard = language_standard(group.flags); !standard.empty())
+                    compile_group += fmt::format(R"(,"languageStandard":{{"backtraces":[],"standard":"{}"}})", xc::json_escape(standard));
+                compile_groups.push_back(compile_group + "}");
+            }
+
+            auto type = cmake_type(target.kind);
+            auto object = fmt::format(R"({{"name":"{}","id":"{}","type":"{}","paths":{{"source":".","build":"."}},"sources":{},"sourceGroups":[{{"name":"Source Files","sourceIndexes":{}}}],"compileGroups":{})",
+                                      xc::json_escape(target.name),
+                                      xc::json_escape(id),
+                                      type,
+                                      json_array(sources, [](const auto& source) { return source; }),
+                                      json_indexes(source_indexes),
+                                      json_array(compile_groups, [](const auto& group) { return group; }));
+            object += fmt::format(R"(,"dependencies":{})", json_array(target.deps, [&directory_id](const auto& dep) {
+                                      return fmt::format(R"({{"id":"{}::@{}"}})", xc::json_escape(dep), directory_id);
+                                  }));
+            if (!target.output.empty())
+            {
+                object += fmt::format(R"(,"nameOnDisk":"{}","artifacts":[{{"path":"{}"}}])",
+                                      xc::json_escape(fs::path{ target.output }.filename().generic_string()),
+                                      json_path(target.output, build));
+            }
+            if (type == "EXECUTABLE" || type == "SHARED_LIBRARY")
+            {
+                // c++ objects are linked by the c++ driver
+                auto cxx = target.groups.empty() || std::ranges::any_of(target.groups, [](const auto& group) { return group.kind == "cxx"; });
+                auto language = cxx ? std::string_view{ "CXX" } : cmake_language(target.groups.front().kind);
+                object += fmt::format(R"(,"link":{{"language":"{}","commandFragments":[]}})", language);
+            }
+            return object + R"(,"backtraceGraph":{"commands":[],"files":[],"nodes":[]}})";
+        }
+    } // namespace
+
+    bool write_file_api_reply(const std::filesystem::path& source_directory,
+                              const std::filesystem::path& build_directory,
+                              const std::string& configuration,
+                              const xc::project_info& project)
+    {
+        auto source = directory_path(source_directory);
+        auto build = directory_path(build_directory);
+        auto reply = build / ".cmake" / "api" / "v1" / "reply";
+
+        // the index names are timestamps, the last one is read by the clients
+        std::error_code ec;
+        fs::path index_file;
+        for (const auto& entry : fs::directory_iterator{ reply, ec })
+        {
+            auto name = entry.path().filename().string();
+            if (name.starts_with("index-") && name.ends_with(".json") && (index_file.empty() || entry.path() > index_file)) index_file = entry.path();
+        }
+        if (index_file.empty()) return false;
+        auto index = xc::read_file(index_file);
+
+        static const std::regex object_pattern{ R"((codemodel-v2|cmakeFiles-v1|cache-v2|toolchains-v1)-[0-9A-Za-z]+\.json)" };
+        std::map<std::string, std::string> previous;
+        for (auto it = std::sregex_iterator{ index.begin(), index.end(), object_pattern }; it != std::sregex_iterator{}; ++it)
+        {
+            previous[(*it)[1].str()] = it->str();
+        }
+        if (!previous.contains("codemodel-v2")) return false;
+        for (const auto* kind : { "cache-v2", "toolchains-v1" })
+        {
+            if (!previous.contains(kind) || !fs::exists(reply / previous[kind])) return false;
+        }
+
+        std::set<std::string> written;
+        auto directory_id = xc::fingerprint{}.add(source.generic_string()).str();
+
+        std::vector<std::string> targets;
+        std::vector<std::size_t> target_indexes;
+        for (const auto& target : project.targets)
+        {
+            auto id = fmt::format("{}::@{}", target.name, directory_id);
+            auto file = write_object(reply, fmt::format("target-{}-{}", target.name, configuration), target_object(target, id, directory_id, source, build));
+            written.insert(file);
+            target_indexes.push_back(targets.size());
+            targets.push_back(fmt::format(R"({{"name":"{}","id":"{}","directoryIndex":0,"projectIndex":0,"jsonFile":"{}"}})", xc::json_escape(target.name), xc::json_escape(id), file));
+        }
+
+        auto directory_file = write_object(reply, "directory-.-" + configuration, R"({"backtraceGraph":{"commands":[],"files":[],"nodes":[]},"installers":[],"paths":{"build":".","source":"."}})");
+        written.insert(directory_file);
+
+        auto codemodel = fmt::format(R"({{"kind":"codemodel","version":{{"major":2,"minor":3}},"paths":{{"source":"{}","build":"{}"}},"configurations":[{{"name":"{}",)"
+                                     R"("directories":[{{"source":".","build":".","jsonFile":"{}","projectIndex":0,"targetIndexes":{}}}],)"
+                                     R"("projects":[{{"name":"{}","directoryIndexes":[0],"targetIndexes":{}}}],"targets":{}}}]}})",
+                                     xc::json_escape(source.generic_string()),
+                                     xc::json_escape(build.generic_string()),
+                                     xc::json_escape(configuration),
+                                     directory_file,
+                                     json_indexes(target_indexes),
+                                     xc::json_escape(project.name),
+                                     json_indexes(target_indexes),
+                                     json_array(targets, [](const auto& target) { return target; }));
+        auto codemodel_file = write_object(reply, "codemodel-v2", codemodel);
+        xc::str_replace(index, previous["codemodel-v2"], codemodel_file);
+
+        // the xmake files are the inputs of the project, an ide reloads it when they change
+        if (previous.contains("cmakeFiles-v1"))
+        {
+            std::vector<std::string> inputs{ (source / "CMakeLists.txt").generic_string() };
+            inputs.insert(inputs.end(), project.inputs.begin(), project.inputs.end());
+            auto cmake_files = fmt::format(R"({{"kind":"cmakeFiles","version":{{"major":1,"minor":0}},"paths":{{"source":"{}","build":"{}"}},"inputs":{}}})",
+                                           xc::json_escape(source.generic_string()),
+                                           xc::json_escape(build.generic_string()),
+                                           json_array(inputs, [&source](const auto& input) {
+                                               auto path = json_path(input, source);
+                                               if (fs::path{ path }.is_absolute()) return fmt::format(R"({{"path":"{}","isExternal":true}})", path);
+                                               return fmt::format(R"({{"path":"{}"}})", path);
+                                           }));
+            auto cmake_files_file = write_object(reply, "cmakeFiles-v1", cmake_files);
+            xc::str_replace(index, previous["cmakeFiles-v1"], cmake_files_file);
+        }
+
+        auto now = std::chrono::system_clock::now();
+        auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+        auto index_name = fmt::format("index-{:%Y-%m-%dT%H-%M-%S}-{:04}.json", fmt::gmtime(std::chrono::system_clock::to_time_t(now)), milliseconds);
+        if (index_name <= index_file.filename().string()) index_name = index_file.stem().string() + "_1.json";
+        xc::write_file(reply / index_name, index);
+
+        // objects which are not referenced anymore are removed, as cmake does
+        static const std::regex file_pattern{ R"([0-9A-Za-z_.+-]+\.json)" };
+        std::set<std::string> referenced{ index_name };
+        for (auto it = std::sregex_iterator{ index.begin(), index.end(), file_pattern }; it != std::sregex_iterator{}; ++it) referenced.insert(it->str());
+        std::vector<fs::path> stale;
+        for (const auto& entry : fs::directory_iterator{ reply, ec })
+        {
+            auto name = entry.path().filename().string();
+            if (name.ends_with(".json") && !referenced.contains(name) && !written.contains(name)) stale.push_back(entry.path());
+        }
+        for (const auto& path : stale) fs::remove(path, ec);
+        return true;
+    }
+} // xc
@@ -0,0 +1,154 @@
+#include <xc/launcher.hpp>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace xc
+{
+    namespace
+    {
+        struct spawn_attributes
+        {
+            posix_spawn_file_actions_t actions;
+            posix_spawnattr_t attributes;
+
+            spawn_attributes()
+            {
+                posix_spawn_file_actions_init(&actions);
+                posix_spawnattr_init(&attributes);
+            }
+            ~spawn_attributes()
+            {
+                posix_spawn_file_actions_destroy(&actions);
+                posix_spawnattr_destroy(&attributes);
+            }
+        };
+
+        void close_pipe(int (&fds)[2])
+        {
+            for (auto& fd : fds)
+            {
+                if (fd >= 0) ::close(fd);
+                fd = -1;
+            }
+        }
+    } // namespace
+
+    int launch(const std::vector<std::string>& args,
+               const std::string& working_directory,
+               const xc::environment& environment,
+               xc::function_ref<void(std::int64_t)> started,
+               xc::output_reader read_stdout,
+               xc::output_reader read_stderr)
+    {
+        if (args.empty()) return 127;
+
+        int out[2]{ -1, -1 };
+        int err[2]{ -1, -1 };
+        if (::pipe2(out, O_CLOEXEC) != 0 || ::pipe2(err, O_CLOEXEC) != 0)
+        {
+            auto message = std::string{ "xc: unable to create pipes: " } + std::strerror(errno);
+            read_stderr(message.data(), message.size());
+            close_pipe(out);
+            close_pipe(err);
+            return 127;
+        }
+
+        // the duplicated descriptors don't inherit O_CLOEXEC, the pipe ends are closed by exec
+        spawn_attributes spawn;
+        posix_spawn_file_actions_addopen(&spawn.actions, 0, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_adddup2(&spawn.actions, out[1], 1);
+        posix_spawn_file_actions_adddup2(&spawn.actions, err[1], 2);
+        if (!working_directory.empty() && working_directory != ".") posix_spawn_file_actions_addchdir_np(&spawn.actions, working_directory.c_str());
+
+        // own process group for the supervisor, default signal handling and mask like a fresh process
+        sigset_t signals;
+        sigemptyset(&signals);
+        posix_spawnattr_setsigmask(&spawn.attributes, &signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGPIPE);
+        posix_spawnattr_setsigdefault(&spawn.attributes, &signals);
+        posix_spawnattr_setpgroup(&spawn.attributes, 0);
+        posix_spawnattr_setflags(&spawn.attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+        std::vector<char*> argv;
+        argv.reserve(args.size() + 1);
+        for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        std::vector<std::string> variables;
+        std::vector<char*> envp;
+        if (!environment.empty())
+        {
+            for (const auto& [name, value] : xc::process_environment(environment)) variables.push_back(name + "=" + value);
+            for (auto& variable : variables) envp.push_back(variable.data());
+            envp.push_back(nullptr);
+        }
+
+        pid_t pid = 0;
+        int spawn_error = ::posix_spawnp(&pid, argv[0], &spawn.actions, &spawn.attributes, argv.data(), envp.empty() ? environ : envp.data());
+        ::close(out[1]);
+        ::close(err[1]);
+        if (spawn_error != 0)
+        {
+            auto message = "xc: unable to start " + args[0] + ": " + std::strerror(spawn_error);
+            read_stderr(message.data(), message.size());
+            ::close(out[0]);
+            ::close(err[0]);
+            return 127;
+        }
+        started(pid);
+
+        // both pipes are drained until the child and its descendants close them
+        constexpr std::size_t buffer_size = 64 * 1024;
+        thread_local std::unique_ptr<char[]> buffer{ new char[buffer_size] };
+        pollfd fds[2]{ { out[0], POLLIN, 0 }, { err[0], POLLIN, 0 } };
+        int open = 2;
+        while (open > 0)
+        {
+            if (::poll(fds, 2, -1) < 0)
+            {
+                if (errno == EINTR) continue;
+                break;
+            }
+            for (auto& fd : fds)
+            {
+                if (fd.fd < 0 || !(fd.revents & (POLLIN | POLLHUP | POLLERR))) continue;
+                auto n = ::read(fd.fd, buffer.get(), buffer_size);
+                if (n > 0) (&fd == &fds[0] ? read_stdout : read_stderr)(buffer.get(), static_cast<std::size_t>(n));
+                else if (n == 0 || errno != EINTR)
+                {
+                    ::close(fd.fd);
+                    fd.fd = -1;
+                    --open;
+                }
+            }
+        }
+        for (auto& fd : fds)
+        {
+            if (fd.fd >= 0) ::close(fd.fd);
+        }
+
+        int status = 0;
+        while (::waitpid(pid, &status, 0) < 0)
+        {
+            if (errno != EINTR) return 127;
+        }
+        if (WIFEXITED(status)) return WEXITSTATUS(status);
+        if (WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+        return 1;
+    }
+} // xc
+#endif
@@ -0,0 +1,27 @@
+#include <xc/mapping.hpp>
+
+#include <xc/utility.hpp>
+
+#include <filesystem>
+
+namespace xc
+{
+    std::vector<xc::applied_mapping> map_cmake_entries(const xc::command& command)
+    {
+        std::vector<xc::applied_mapping> mappings;
+        for (const auto& mapping : xc::cmake_mappings)
+        {
+            auto value = command.value(mapping.entry);
+            if (value.empty()) continue;
+
+            // ccache, /usr/bin/ccache, ccache.exe
+            bool enabled = mapping.kind == cmake_mapping::kind::launcher ? std::filesystem::path{ value }.stem() == "ccache" : xc::is_on(value);
+            // a disabled flag is the xmake default, another launcher is reported as unsupported
+            if (!enabled && mapping.kind == cmake_mapping::kind::flag) continue;
+
+            if (enabled && !mapping.option.empty()) mappings.push_back({ mapping.entry, value, mapping.option, mapping.value, {} });
+            else mappings.push_back({ mapping.entry, value, {}, {}, mapping.note });
+        }
+        return mappings;
+    }
+} // xc
@@ -0,0 +1,52 @@
+#include <xc/metrics.hpp>
+
+#include <xc/utility.hpp>
+
+#include <fmt/core.h>
+
+#include <cstdio>
+#include <mutex>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace xc
+{
+    void write_metrics(const std::filesystem::path& path, const xc::run_metrics& metrics)
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+
+#if defined(_WIN32)
+        auto pid = ::_getpid();
+#else
+        auto pid = ::getpid();
+#endif
+        auto line = fmt::format(
+            R"({{"time":{},"pid":{},"phase":"{}","program":"{}","command":"{}","exit_code":{},"spawn_us":{},"first_output_us":{},"total_us":{},"bytes":{},"lines":{}}})"
+            "\n",
+            duration_cast<milliseconds>(metrics.start.time_since_epoch()).count(),
+            pid,
+            xc::json_escape(metrics.phase),
+            xc::json_escape(metrics.program),
+            xc::json_escape(metrics.command),
+            metrics.exit_code,
+            metrics.spawn.count(),
+            metrics.first_output.count(),
+            metrics.total.count(),
+            metrics.bytes,
+            metrics.lines);
+
+        // a single append write per line, lines of concurrent xc processes are not interleaved
+        static std::mutex mutex;
+        std::lock_guard lock{ mutex };
+        if (auto* file = std::fopen(path.string().c_str(), "ab"))
+        {
+            std::fwrite(line.data(), 1, line.size(), file);
+            std::fclose(file);
+        }
+    }
+} // xc
@@ -0,0 +1,37 @@
+#include <xc/progress.hpp>
+
+#include <cstdlib>
+#include <string_view>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace xc
+{
+    xc::progress_mode detect_progress_mode()
+    {
+        const char* value = std::getenv("XC_PROGRESS");
+        std::string_view mode = value ? value : "auto";
+        if (mode == "line") return progress_mode::line;
+        if (mode == "full") return progress_mode::full;
+
+#if defined(_WIN32)
+        bool terminal = _isatty(1);
+#else
+        bool terminal = ::isatty(STDOUT_FILENO);
+#endif
+        // CLion runs cmake with CLION_IDE set and renders carriage returns in its build console
+        if (terminal || std::getenv("CLION_IDE")) return progress_mode::line;
+        return progress_mode::full;
+    }
+
+    std::chrono::milliseconds progress_interval()
+    {
+        const char* value = std::getenv("XC_PROGRESS_INTERVAL");
+        int interval = value ? std::atoi(value) : 100;
+        return std::chrono::milliseconds{ interval > 0 ? interval : 0 };
+    }
+} // xc
@@ -0,0 +1,165 @@
+#include <xc/project.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+namespace xc
+{
+    // one "key value" entry per line, the sources and flags of a group follow its "group" line
+    // the output is renamed once complete so that a failing script leaves no partial file
+    const std::string_view project_script = R"lua(
+import("core.project.config")
+import("core.project.project")
+import("core.tool.compiler")
+
+local flag_prefixes = {
+    { "-isystem", "system_include" }, { "-external:I", "system_include" }, { "/external:I", "system_include" },
+    { "-I", "include" }, { "/I", "include" }, { "-D", "define" }, { "/D", "define" } }
+
+function _write_flags(file, flags)
+    local i = 1
+    while i <= #flags do
+        local flag = flags[i]
+        local key, value
+        for _, prefix in ipairs(flag_prefixes) do
+            if flag:startswith(prefix[1]) then
+                key = prefix[2]
+                value = flag:sub(#prefix[1] + 1)
+                if value == "" then
+                    i = i + 1
+                    value = flags[i] or ""
+                end
+                break
+            end
+        end
+        if key == "define" then file:print("define %s", value)
+        elseif key then file:print("%s %s", key, path.absolute(value))
+        else file:print("flag %s", flag) end
+        i = i + 1
+    end
+end
+
+function main(output)
+    config.load()
+    local file = io.open(output .. ".tmp", "w")
+    file:print("project %s", project.name() or "")
+    for _, input in ipairs(project.allfiles()) do
+        file:print("input %s", path.absolute(input))
+    end
+    for _, target in ipairs(project.ordertargets()) do
+        local kind = target:kind()
+        file:print("target %s", target:name())
+        file:print("kind %s", kind)
+        if kind == "binary" or kind == "static" or kind == "shared" then
+            file:print("output %s", path.absolute(target:targetfile()))
+        end
+        for _, dep in ipairs(table.wrap(target:get("deps"))) do
+            file:print("dep %s", dep)
+        end
+        local batches = target:sourcebatches()
+        local names = table.keys(batches)
+        table.sort(names)
+        for _, name in ipairs(names) do
+            local batch = batches[name]
+            if batch.sourcekind and #batch.sourcefiles > 0 then
+                file:print("group %s", batch.sourcekind)
+                for _, sourcefile in ipairs(batch.sourcefiles) do
+                    file:print("source %s", path.absolute(sourcefile))
+                end
+                _write_flags(file, compiler.compflags(batch.sourcefiles[1], { target = target, sourcekind = batch.sourcekind }))
+            end
+        end
+    end
+    file:close()
+    os.mv(output .. ".tmp", output)
+end
+)lua";
+
+    project_info read_project_info(const std::filesystem::path& path)
+    {
+        std::ifstream ifs{ path };
+        if (!ifs) throw std::runtime_error{ "unable to read project info " + path.string() };
+
+        project_info info;
+        std::string line;
+        while (std::getline(ifs, line))
+        {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            auto offset = line.find(' ');
+            if (offset == std::string::npos) continue;
+            std::string_view key{ line.data(), offset };
+            auto value = line.substr(offset + 1);
+
+            if (key == "project") info.name = std::move(value);
+            else if (key == "input") info.inputs.emplace_back(std::move(value));
+            else if (key == "target") info.targets.emplace_back().name = std::move(value);
+            else if (info.targets.empty()) continue;
+            else
+            {
+                auto& target = info.targets.back();
+                if (key == "kind") target.kind = std::move(value);
+                else if (key == "output") target.output = std::move(value);
+                else if (key == "dep") target.deps.emplace_back(std::move(value));
+                else if (key == "group") target.groups.emplace_back().kind = std::move(value);
+                else if (target.groups.empty()) continue;
+                else if (key == "source") target.groups.back().sources.emplace_back(std::move(value));
+                else if (key == "include") target.groups.back().includes.emplace_back(std::move(value));
+                else if (key == "system_include") target.groups.back().system_includes.emplace_back(std::move(value));
+                else if (key == "define") target.groups.back().defines.emplace_back(std::move(value));
+                else if (key == "flag") target.groups.back().flags.emplace_back(std::move(value));
+            }
+        }
+        return info;
+    }
+
+    std::optional<project_source> find_source(const project_info& info, std::string_view file)
+    {
+        if (file.empty()) return std::nullopt;
+        for (const auto& target : info.targets)
+        {
+            for (const auto& group : target.groups)
+            {
+                for (std::string_view source : group.sources)
+                {
+                    if (source == file) return project_source{ target.name, source };
+                    if (source.size() > file.size() && source.ends_with(file))
+                    {
+                        auto separator = source[source.size() - file.size() - 1];
+                        if (separator == '/' || separator == '\\') return project_source{ target.name, source };
+                    }
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::string_view owning_target(const project_info& info, std::string_view file)
+    {
+        auto source = find_source(info, file);
+        return source ? source->target : std::string_view{};
+    }
+
+    std::optional<project_source> parse_object_target(std::string_view name)
+    {
+        std::string_view extension;
+        if (name.ends_with(".obj")) extension = ".obj";
+        else if (name.ends_with(".o")) extension = ".o";
+        else return std::nullopt;
+
+        project_source object{ {}, name.substr(0, name.size() - extension.size()) };
+        // the object of src/main.cpp is src/main.cpp.o
+        if (object.path.rfind('.') == std::string_view::npos || object.path.ends_with('/')) return std::nullopt;
+
+        constexpr std::string_view prefix{ "CMakeFiles/" };
+        if (auto begin = object.path.find(prefix); begin != std::string_view::npos)
+        {
+            auto target = object.path.substr(begin + prefix.size());
+            if (auto end = target.find(".dir/"); end != std::string_view::npos)
+            {
+                object.target = target.substr(0, end);
+                object.path = target.substr(end + 5);
+            }
+        }
+        return object;
+    }
+} // xc
@@ -0,0 +1,81 @@
+#include <xc/supervisor.hpp>
+
+#include <process.hpp>
+
+#include <csignal>
+
+#if !defined(_WIN32)
+#include <signal.h>
+#endif
+
+namespace xc
+{
+    supervisor& supervisor::instance()
+    {
+        static supervisor supervisor;
+        return supervisor;
+    }
+
+    void supervisor::install()
+    {
+#if !defined(_WIN32)
+        struct sigaction action
+        {};
+        action.sa_handler = &supervisor::forward;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+#endif
+    }
+
+    void supervisor::add(std::int64_t id)
+    {
+        for (auto& child : children_)
+        {
+            std::int64_t empty = 0;
+            if (child.compare_exchange_strong(empty, id)) return;
+        }
+    }
+
+    void supervisor::remove(std::int64_t id)
+    {
+        for (auto& child : children_)
+        {
+            auto expected = id;
+            if (child.compare_exchange_strong(expected, 0)) return;
+        }
+    }
+
+    void supervisor::terminate()
+    {
+        for (auto& child : children_)
+        {
+            if (auto id = child.load()) TinyProcessLib::Process::kill(static_cast<TinyProcessLib::Process::id_type>(id), true);
+        }
+    }
+
+    // signal handler, only async signal safe calls
+    void supervisor::forward(int signal)
+    {
+        auto& self = instance();
+        self.signal_.store(signal);
+#if !defined(_WIN32)
+        bool forwarded = false;
+        for (auto& child : self.children_)
+        {
+            if (auto id = child.load())
+            {
+                ::kill(-static_cast<pid_t>(id), signal);
+                forwarded = true;
+            }
+        }
+        // no child to wait for, the default action terminates xc
+        if (!forwarded)
+        {
+            ::signal(signal, SIG_DFL);
+            ::raise(signal);
+        }
+#endif
+    }
+} // xc
@@ -0,0 +1,68 @@
+#include <xc/timeline.hpp>
+
+#include <xc/utility.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+namespace xc
+{
+    timeline::timeline(std::size_t jobs)
+        : serial_{ jobs == 1 }
+        , start_{ clock::now() }
+    {}
+
+    void timeline::add(const xc::progress& progress)
+    {
+        auto now = clock::now();
+        if (serial_ && !jobs_.empty()) jobs_.back().end = now;
+        jobs_.push_back(job{ std::string{ progress.name }, std::string{ progress.action }, now, std::nullopt });
+    }
+
+    void timeline::finish()
+    {
+        if (serial_ && !jobs_.empty() && !jobs_.back().end) jobs_.back().end = clock::now();
+    }
+
+    void timeline::write_trace(const std::filesystem::path& path) const
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+
+        std::ofstream ofs{ path, std::ios::trunc };
+        if (!ofs) throw std::runtime_error{ "unable to write trace " + path.string() };
+
+        ofs << R"({"displayTimeUnit":"ms","traceEvents":[)";
+        for (std::size_t i = 0; i < jobs_.size(); ++i)
+        {
+            const auto& job = jobs_[i];
+            auto name = xc::json_escape(job.name);
+            auto action = xc::json_escape(job.action);
+            auto ts = duration_cast<microseconds>(job.start - start_).count();
+            ofs << (i ? "," : "") << '\n';
+            if (job.end)
+            {
+                ofs << fmt::format(R"({{"name":"{}","cat":"{}","ph":"X","pid":1,"tid":1,"ts":{},"dur":{}}})",
+                                   name, action, ts, duration_cast<microseconds>(*job.end - job.start).count());
+            }
+            else ofs << fmt::format(R"({{"name":"{}","cat":"{}","ph":"i","s":"p","pid":1,"tid":1,"ts":{}}})", name, action, ts);
+        }
+        ofs << "\n]}\n";
+    }
+
+    std::vector<const timeline::job*> timeline::slowest(std::size_t count) const
+    {
+        std::vector<const job*> jobs;
+        for (const auto& job : jobs_)
+        {
+            if (job.end) jobs.push_back(&job);
+        }
+        count = std::min(count, jobs.size());
+        std::partial_sort(jobs.begin(), jobs.begin() + count, jobs.end(), [](const job* a, const job* b) { return *a->end - a->start > *b->end - b->start; });
+        jobs.resize(count);
+        return jobs;
+    }
+} // xc
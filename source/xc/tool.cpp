@@ -0,0 +1,156 @@
+#include <xc/tool.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace xc
+{
+    std::filesystem::path find_program(const std::string& name)
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+
+        fs::path program{ name };
+        if (program.has_parent_path()) return fs::exists(program, ec) ? fs::absolute(program, ec) : fs::path{};
+
+#if defined(_WIN32)
+        constexpr char separator = ';';
+        std::vector<std::string> extensions{ ".exe", ".bat", ".cmd", "" };
+#else
+        constexpr char separator = ':';
+        std::vector<std::string> extensions{ "" };
+#endif
+        const char* env_path = std::getenv("PATH");
+        if (!env_path) return {};
+
+        std::string_view paths{ env_path };
+        while (!paths.empty())
+        {
+            auto offset = paths.find(separator);
+            auto directory = paths.substr(0, offset);
+            paths = offset == std::string_view::npos ? std::string_view{} : paths.substr(offset + 1);
+            if (directory.empty()) continue;
+
+            for (const auto& extension : extensions)
+            {
+                auto candidate = fs::path{ directory } / (name + extension);
+                if (fs::is_regular_file(candidate, ec)) return candidate;
+            }
+        }
+        return {};
+    }
+
+    std::string program_identity(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        auto canonical = std::filesystem::canonical(path, ec);
+        if (ec) return {};
+        auto size = std::filesystem::file_size(canonical, ec);
+        auto time = std::filesystem::last_write_time(canonical, ec);
+
+        return canonical.string() + "|" + std::to_string(size) + "|" + std::to_string(time.time_since_epoch().count());
+    }
+
+    xc::environment process_environment(const xc::environment& overrides)
+    {
+#if defined(_WIN32)
+        char** variables = _environ;
+#else
+        char** variables = environ;
+#endif
+        xc::environment environment;
+        for (; variables && *variables; ++variables)
+        {
+            std::string_view variable{ *variables };
+            auto offset = variable.find('=');
+            // windows has hidden variables starting with =
+            if (offset == std::string_view::npos || offset == 0) continue;
+            environment.emplace(variable.substr(0, offset), variable.substr(offset + 1));
+        }
+        for (const auto& [name, value] : overrides) environment[name] = value;
+        return environment;
+    }
+
+    bool spawn_detached(const std::vector<std::string>& args)
+    {
+#if defined(_WIN32)
+        return false;
+#else
+        std::vector<char*> argv;
+        for (const auto& arg : args) argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        // double fork so that the process is reparented and never becomes a zombie
+        auto pid = ::fork();
+        if (pid < 0) return false;
+        if (pid == 0)
+        {
+            ::setsid();
+            if (::fork() != 0) ::_exit(0);
+
+            int null = ::open("/dev/null", O_RDWR);
+            ::dup2(null, 0);
+            ::dup2(null, 1);
+            ::dup2(null, 2);
+            ::execv(argv[0], argv.data());
+            ::_exit(127);
+        }
+        int status = 0;
+        ::waitpid(pid, &status, 0);
+        return true;
+#endif
+    }
+
+    std::filesystem::path current_executable(const std::string& argv0)
+    {
+        std::error_code ec;
+#if defined(__linux__)
+        auto path = std::filesystem::read_symlink("/proc/self/exe", ec);
+        if (!ec) return path;
+#endif
+        if (argv0.find_first_of("/\\") == std::string::npos) return find_program(argv0);
+        return std::filesystem::absolute(argv0, ec);
+    }
+
+    std::filesystem::path cache_directory()
+    {
+        if (const char* path = std::getenv("XC_CACHE_DIR")) return path;
+#if defined(_WIN32)
+        if (const char* path = std::getenv("LOCALAPPDATA")) return std::filesystem::path{ path } / "xc";
+#else
+        if (const char* path = std::getenv("XDG_CACHE_HOME")) return std::filesystem::path{ path } / "xc";
+        if (const char* path = std::getenv("HOME")) return std::filesystem::path{ path } / ".cache" / "xc";
+#endif
+        return std::filesystem::temp_directory_path() / "xc";
+    }
+
+    file_lock::file_lock(const std::filesystem::path& path)
+    {
+#if !defined(_WIN32)
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ >= 0)
+        {
+            while (::flock(fd_, LOCK_EX) != 0 && errno == EINTR) {}
+        }
+#endif
+    }
+
+    file_lock::~file_lock()
+    {
+#if !defined(_WIN32)
+        // closing the file releases the lock
+        if (fd_ >= 0) ::close(fd_);
+#endif
+    }
+} // xc
@@ -0,0 +1,174 @@
+#include <xc/watch.hpp>
+
+#include <xc/command.hpp>
+#include <xc/console.hpp>
+#include <xc/tool.hpp>
+#include <xc/xcmake.hpp>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace xc::watch
+{
+#if !defined(__linux__)
+    void update(const std::string&, const std::filesystem::path&, bool) {}
+
+    int serve(const std::string&, const std::filesystem::path&, std::chrono::milliseconds)
+    {
+        std::fputs("xc watch is not supported on this platform\n", stderr);
+        return 1;
+    }
+#else
+    namespace
+    {
+        std::filesystem::path pid_file(const std::filesystem::path& build_directory) { return build_directory / ".xc" / "watch.pid"; }
+
+        pid_t read_pid(const std::filesystem::path& path)
+        {
+            std::ifstream ifs{ path };
+            pid_t pid = 0;
+            ifs >> pid;
+            return pid;
+        }
+
+        // the directories scanned by lua_fingerprint : hidden, build and the build directory are skipped
+        void add_watches(int fd, const std::filesystem::path& root, const std::filesystem::path& excluded, std::unordered_map<int, std::filesystem::path>& directories)
+        {
+            namespace fs = std::filesystem;
+            std::error_code ec;
+            auto add = [&](const fs::path& path) {
+                int wd = ::inotify_add_watch(fd, path.c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+                if (wd >= 0) directories[wd] = path;
+            };
+
+            add(root);
+            for (auto it = fs::recursive_directory_iterator{ root, fs::directory_options::skip_permission_denied, ec };
+                 it != fs::recursive_directory_iterator{};
+                 it.increment(ec))
+            {
+                if (ec) break;
+                if (!it->is_directory(ec)) continue;
+                auto name = it->path().filename().string();
+                if (name.starts_with(".") || name == "build" || fs::weakly_canonical(it->path(), ec) == excluded) it.disable_recursion_pending();
+                else add(it->path());
+            }
+        }
+
+        std::vector<std::string> read_arguments(const std::filesystem::path& build_directory)
+        {
+            std::vector<std::string> args;
+            std::ifstream ifs{ build_directory / ".xc" / "arguments.txt" };
+            std::string arg;
+            while (std::getline(ifs, arg)) args.emplace_back(std::move(arg));
+            return args;
+        }
+    } // namespace
+
+    void update(const std::string& program, const std::filesystem::path& build_directory, bool enabled)
+    {
+        std::error_code ec;
+        auto path = pid_file(build_directory);
+        auto pid = read_pid(path);
+        bool running = pid > 0 && ::kill(pid, 0) == 0;
+
+        // the watcher exits once its pid file is gone
+        if (!enabled)
+        {
+            std::filesystem::remove(path, ec);
+            return;
+        }
+        if (!running) xc::spawn_detached({ xc::current_executable(program).string(), "--xc-watch", std::filesystem::absolute(build_directory, ec).string() });
+    }
+
+    int serve(const std::string& program, const std::filesystem::path& build_directory, std::chrono::milliseconds delay)
+    {
+        namespace fs = std::filesystem;
+        using clock = std::chrono::steady_clock;
+        std::error_code ec;
+
+        auto args = read_arguments(build_directory);
+        if (args.empty()) return 1;
+        auto command = xc::parse_command(args);
+        fs::path source_directory{ command.source_directory.empty() ? "." : command.source_directory };
+
+        auto path = pid_file(build_directory);
+        auto pid = ::getpid();
+        {
+            std::ofstream ofs{ path, std::ios::trunc };
+            ofs << pid;
+        }
+
+        int fd = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        if (fd < 0) return 1;
+        std::unordered_map<int, fs::path> directories;
+        add_watches(fd, source_directory, fs::weakly_canonical(build_directory, ec), directories);
+
+        bool pending = false;
+        clock::time_point last_change;
+        alignas(inotify_event) char buffer[64 * 1024];
+        while (true)
+        {
+            // a pending change waits for the end of the debounce delay, otherwise the pid file is checked every second
+            auto timeout = pending ? std::max(std::chrono::milliseconds{ 0 }, std::chrono::duration_cast<std::chrono::milliseconds>(last_change + delay - clock::now()))
+                                   : std::chrono::milliseconds{ 1000 };
+            pollfd poll_fd{ fd, POLLIN, 0 };
+            int ready = ::poll(&poll_fd, 1, static_cast<int>(timeout.count()));
+            if (ready < 0 && errno != EINTR) break;
+
+            if (ready > 0)
+            {
+                ssize_t size = 0;
+                while ((size = ::read(fd, buffer, sizeof(buffer))) > 0)
+                {
+                    for (char* data = buffer; data < buffer + size;)
+                    {
+                        auto* event = reinterpret_cast<inotify_event*>(data);
+                        data += sizeof(inotify_event) + event->len;
+
+                        std::string_view name{ event->len ? event->name : "" };
+                        if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)) && directories.contains(event->wd))
+                        {
+                            if (name.starts_with(".") || name == "build") continue;
+                            add_watches(fd, directories[event->wd] / name, fs::weakly_canonical(build_directory, ec), directories);
+                            // a created directory is empty, a moved one may bring lua files
+                            if (!(event->mask & IN_MOVED_TO)) continue;
+                            pending = true;
+                        }
+                        else if (name.ends_with(".lua")) pending = true;
+                        else continue;
+                        last_change = clock::now();
+                    }
+                }
+                continue;
+            }
+
+            if (read_pid(path) != pid) break;
+            if (!pending || clock::now() < last_change + delay) continue;
+
+            pending = false;
+            try
+            {
+                xc::xcmake xcmake{ program, read_arguments(build_directory) };
+                xcmake.pregenerate();
+            }
+            catch (const std::exception& e)
+            {
+                xc::console::instance().write({ "xc exception: ", e.what(), "\n" });
+            }
+            xc::console::instance().flush();
+        }
+        ::close(fd);
+        return 0;
+    }
+#endif
+} // xc::watch
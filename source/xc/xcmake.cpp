@@ -1,14 +1,39 @@
 #include <xc/xcmake.hpp>
 
+#include <xc/cache.hpp>
+#include <xc/console.hpp>
+#include <xc/diagnostic_filter.hpp>
+#include <xc/diagnostics_log.hpp>
+#include <xc/file_api.hpp>
+#include <xc/launcher.hpp>
+#include <xc/line_framer.hpp>
 #include <xc/mapping.hpp>
+#include <xc/metrics.hpp>
+#include <xc/progress.hpp>
+#include <xc/project.hpp>
+#include <xc/supervisor.hpp>
+#include <xc/timeline.hpp>
+#include <xc/tool.hpp>
 #include <xc/utility.hpp>
+#include <xc/watch.hpp>
 
 #include <process.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdlib>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
 #include <ranges>
 
 namespace xc
@@ -16,105 +41,281 @@ namespace xc
     xcmake::xcmake(std::string program, std::vector<std::string> args)
         : program_{ std::move(program) }
         , args_{ std::move(args) }
-        , parameters_{ cmake_parse_args(args_) }
+        , command_{ xc::parse_command(args_) }
         , working_directory_{ "." }
         , colorize_console_{ false }
         , verbose_{ false }
-        , clogger_{ [this](std::string data) { log_cmake(std::move(data)); } }
-        , xlogger_{ [this](std::string data) { log_xmake(std::move(data)); } }
+        , pregenerate_{ false }
+        , phase_{ "none" }
+        , clogger_{ [this](std::string_view data) { log_cmake(data); } }
+        , xlogger_{ [this](std::string_view data) { log_xmake(data); } }
         , errors_count_{}
         , warnings_count_{}
     {}
 
-    void xcmake::process()
+    int xcmake::process()
     {
         /*
         std::ofstream ofs;
         ofs.open("d:/clion_output.txt", std::ios::app);
-        for (int i = 0; i < parameters_.size(); ++i) ofs << parameters_[i].name << std::endl;
+        for (int i = 0; i < args_.size(); ++i) ofs << args_[i] << std::endl;
         std::cout << "cmake version 3.24.1\n";
         return;*/
-        if (parameters_.empty())
+        phase_ = xc::to_string(command_.mode);
+        if (command_.mode == xc::command_mode::run)
         {
             log("run");
-            run("xmake", "run");
-            return;
+            return run("xmake", "run");
         }
-        else if (parameters_[0].name == "version")
+        else if (command_.mode == xc::command_mode::version)
         {
             auto verbose = verbose_;
             verbose_ = false;
-            std::cout << "cmake version " << cmake_version(); // not working anymore << " | xmake " << xmake_version() << " | xc 1.0.2";
+            xc::console::instance().write({ "cmake version ", cmake_version() }); // not working anymore << " | xmake " << xmake_version() << " | xc 1.0.2";
             verbose_ = verbose;
-            return;
+            return 0;
         }
-        // CLion create a _buildXXX dir in tmp and read values from the CMakeCache.txt in this dir
-        else if (has_parameter("CMAKE_TRY_COMPILE_TARGET_TYPE", xc::parameter_type::user_cmake))
+        else if (command_.mode == xc::command_mode::try_compile)
         {
             auto verbose = verbose_;
             verbose_ = false;
-
-            decltype(args_) args;
-            for (const auto& arg : args_) args.emplace_back("\"" + arg + "\"");
-            run("cmake", args, clogger_);
-
+            auto exit_code = try_compile();
             verbose_ = verbose;
-            return;
+            return exit_code;
         }
-        else if (has_parameter("G")) generate();
-        else if (has_parameter("build")) build();
+        else if (command_.mode == xc::command_mode::generate) return generate();
+        else if (command_.mode == xc::command_mode::build) return build();
+        else if (command_.mode == xc::command_mode::last_errors) return last_errors();
         else
         {
             log("unknown command");
+            return 1;
+        }
+    }
+
+    // CLion create a _buildXXX dir in tmp and read values from the CMakeCache.txt in this dir
+    // the result only depends on the arguments, the compilers and cmake so it is cached across temporary dirs
+    int xcmake::try_compile()
+    {
+        namespace fs = std::filesystem;
+
+        std::string source_directory{ command_.source_directory.empty() ? command_.positional : command_.source_directory };
+        if (source_directory.empty()) source_directory = working_directory_;
+        fs::path build_directory = command_.build_directory.empty() ? working_directory_ : std::string{ command_.build_directory };
+
+        auto to_placeholder = xc::directory_spellings(build_directory, "<xc:build>");
+        for (auto& spelling : xc::directory_spellings(source_directory, "<xc:source>")) to_placeholder.emplace_back(std::move(spelling));
+        std::sort(to_placeholder.begin(), to_placeholder.end(), [](const auto& a, const auto& b) { return a.first.size() > b.first.size(); });
+        xc::path_replacements from_placeholder{
+            { "<xc:build>", fs::absolute(build_directory).lexically_normal().generic_string() },
+            { "<xc:source>", fs::absolute(source_directory).lexically_normal().generic_string() },
+        };
+
+        xc::fingerprint key;
+        for (auto arg : args_)
+        {
+            xc::relocate(arg, to_placeholder);
+            key.add(arg);
+        }
+        // cmake selects the compilers from the cache entries, then CC / CXX, and reads the flags from the environment
+        for (const char* name : { "CC", "CXX", "CFLAGS", "CXXFLAGS", "LDFLAGS" })
+        {
+            const char* value = std::getenv(name);
+            key.add(name).add(value ? value : "");
+        }
+        auto compiler = [this](std::string_view entry, const char* variable, std::string_view fallback) {
+            std::string program{ command_.value(entry) };
+            const char* value = std::getenv(variable);
+            if (program.empty() && value && *value)
+            {
+                // CC="ccache gcc" : the first word is the program unless the whole value is a path
+                std::error_code ec;
+                program = value;
+                if (!fs::exists(program, ec)) program = program.substr(0, program.find(' '));
+            }
+            if (program.empty()) program = fallback;
+            return xc::program_identity(xc::find_program(program));
+        };
+        key.add(compiler("CMAKE_C_COMPILER", "CC", "cc"));
+        key.add(compiler("CMAKE_CXX_COMPILER", "CXX", "c++"));
+        key.add(cmake_version());
+        {
+            std::ifstream ifs{ fs::path{ source_directory } / "CMakeLists.txt", std::ios::binary };
+            std::string cmakelists{ std::istreambuf_iterator<char>{ ifs }, std::istreambuf_iterator<char>{} };
+            xc::relocate(cmakelists, to_placeholder);
+            key.add(cmakelists);
+        }
+
+        constexpr std::array<std::string_view, 3> outputs{ "CMakeCache.txt", "CMakeFiles", ".cmake" };
+        auto entry = xc::cache_directory() / "try-compile" / key.str();
+        std::error_code ec;
+
+        if (fs::exists(entry / "CMakeCache.txt", ec))
+        {
+            for (auto output : outputs)
+            {
+                if (!fs::exists(entry / output, ec)) continue;
+                fs::copy(entry / output, build_directory / output, fs::copy_options::recursive | fs::copy_options::overwrite_existing, ec);
+                xc::relocate_files(build_directory / output, from_placeholder);
+            }
+
+            std::ifstream ifs{ entry / "output.txt" };
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                xc::relocate(line, from_placeholder);
+                log_cmake(line);
+            }
+            return 0;
+        }
+
+        std::string out;
+        auto args = cmake_args();
+        auto exit_code = run("cmake", args, [this, &out](std::string_view data) {
+            out.append(data).push_back('\n');
+            log_cmake(data);
+        });
+
+        // a failed probe is not cached, the next one runs cmake again
+        if (exit_code != 0 || !fs::exists(build_directory / "CMakeCache.txt", ec)) return exit_code;
+
+        auto tmp_entry = entry;
+        tmp_entry += ".tmp" + std::to_string(std::random_device{}());
+        fs::create_directories(tmp_entry, ec);
+        for (auto output : outputs)
+        {
+            if (fs::exists(build_directory / output, ec)) fs::copy(build_directory / output, tmp_entry / output, fs::copy_options::recursive, ec);
+        }
+        {
+            std::ofstream ofs{ tmp_entry / "output.txt", std::ios::binary };
+            ofs << out;
         }
+        xc::relocate_files(tmp_entry, to_placeholder);
+
+        // another process may have stored the same probe meanwhile
+        fs::rename(tmp_entry, entry, ec);
+        if (ec) fs::remove_all(tmp_entry, ec);
+        return 0;
     }
 
-    void xcmake::run(std::vector<std::string>& process_args, const xcmake::output_callback& out) const
+    int xcmake::run(std::vector<std::string>& process_args, xcmake::output_callback out) const { return run(process_args, {}, out); }
+
+    int xcmake::run(std::vector<std::string>& process_args, const xc::environment& environment, xcmake::output_callback out) const
     {
         if (verbose_)
         {
             std::string command;
             for (const auto& arg : process_args)
                 command.append(arg + " ");
-            TinyProcessLib::Process process(
-                process_args,
-                working_directory_,
-                [&command](const char* bytes, size_t n) {
-                    std::cout << "[xc:run] " << command << "\n" << std::string{ bytes, n } << std::endl;
-                },
-                [&command](const char* bytes, size_t n) {
-                    std::cout << "[xc:run] " << command << "\n" << std::string{ bytes, n } << std::endl;
-                });
-            return;
+            xc::console::instance().write({ "[xc:run] ", command, "\n" });
         }
-        else
+
+        // stdout and stderr are read from different threads, lines are delivered one at a time
+        std::mutex output_mutex;
+        xc::line_framer stdout_framer;
+        xc::line_framer stderr_framer;
+        std::size_t lines = 0;
+        auto deliver = [&](std::string_view line) {
+            std::lock_guard lock{ output_mutex };
+            ++lines;
+            if (verbose_) xc::console::instance().write({ "[xc:run] ", line, "\n" });
+            else out(line);
+        };
+
+        // XC_METRICS=<file> appends the measures of every child process
+        const char* metrics_file = std::getenv("XC_METRICS");
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+        std::atomic<std::size_t> bytes_read{ 0 };
+        std::atomic<clock::rep> first_output{ -1 };
+        auto received = [&](std::size_t n) {
+            if (bytes_read.fetch_add(n) == 0)
+            {
+                clock::rep none = -1;
+                first_output.compare_exchange_strong(none, (clock::now() - start).count());
+            }
+        };
+
+        int exit_code = 0;
+        clock::duration spawn{};
         {
-            TinyProcessLib::Process process(
-                process_args,
-                working_directory_,
-                [&out](const char* bytes, size_t n) {
-                    out(std::string{ bytes, n });
-                },
-                [&out](const char* bytes, size_t n) {
-                    out(std::string{ bytes, n });
-                });
+            auto read_stdout = [&](const char* bytes, size_t n) {
+                received(n);
+                stdout_framer.feed({ bytes, n }, deliver);
+            };
+            auto read_stderr = [&](const char* bytes, size_t n) {
+                received(n);
+                stderr_framer.feed({ bytes, n }, deliver);
+            };
+            // the process group receives the signals cancelling xc
+            auto& supervisor = xc::supervisor::instance();
+            std::int64_t id = 0;
+#if defined(__linux__)
+            auto started = [&](std::int64_t pid) {
+                spawn = clock::now() - start;
+                id = pid;
+                supervisor.add(id);
+            };
+            exit_code = xc::launch(process_args, working_directory_, environment, started, read_stdout, read_stderr);
+#else
+            std::optional<TinyProcessLib::Process> process;
+            if (environment.empty()) process.emplace(process_args, working_directory_, read_stdout, read_stderr);
+            else process.emplace(process_args, working_directory_, xc::process_environment(environment), read_stdout, read_stderr);
+            spawn = clock::now() - start;
+
+            id = static_cast<std::int64_t>(process->get_id());
+            if (id > 0) supervisor.add(id);
+            exit_code = process->get_exit_status();
+#endif
+            if (id > 0) supervisor.remove(id);
+        }
+        stdout_framer.flush(deliver);
+        stderr_framer.flush(deliver);
+
+        if (metrics_file)
+        {
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            xc::run_metrics metrics;
+            metrics.phase = phase_;
+            metrics.program = process_args.empty() ? std::string_view{} : std::string_view{ process_args[0] };
+            metrics.command = process_args.size() > 1 ? std::string_view{ process_args[1] } : std::string_view{};
+            // arguments forwarded to cmake are quoted on windows
+            if (metrics.command.size() > 1 && metrics.command.front() == '"' && metrics.command.back() == '"') metrics.command = metrics.command.substr(1, metrics.command.size() - 2);
+            metrics.exit_code = exit_code;
+            metrics.start = std::chrono::system_clock::now() - (clock::now() - start);
+            metrics.spawn = duration_cast<microseconds>(spawn);
+            if (auto first = first_output.load(); first >= 0) metrics.first_output = duration_cast<microseconds>(clock::duration{ first });
+            metrics.total = duration_cast<microseconds>(clock::now() - start);
+            metrics.bytes = bytes_read.load();
+            metrics.lines = lines;
+            xc::write_metrics(metrics_file, metrics);
         }
+        return exit_code;
+    }
+
+    int xcmake::run(std::string_view program, const std::vector<std::string>& args, xcmake::output_callback out) const
+    {
+        std::vector<std::string> reproc_args{ args.size() + 1 };
+        reproc_args[0] = program;
+        std::copy(args.begin(), args.end(), reproc_args.begin() + 1);
+        return run(reproc_args, out);
     }
 
-    void xcmake::run(std::string_view program, const std::vector<std::string>& args, const xcmake::output_callback& out) const
+    int xcmake::run(std::string_view program, const std::vector<std::string>& args, const xc::environment& environment, xcmake::output_callback out) const
     {
         std::vector<std::string> reproc_args{ args.size() + 1 };
         reproc_args[0] = program;
         std::copy(args.begin(), args.end(), reproc_args.begin() + 1);
-        run(reproc_args, out);
+        return run(reproc_args, environment, out);
     }
 
-    void xcmake::run(std::string_view program, const char* args, const xcmake::output_callback& out) const
+    int xcmake::run(std::string_view program, const char* args, xcmake::output_callback out) const
     {
         std::vector<std::string> reproc_args{ 2 };
         reproc_args[0] = program;
         reproc_args[1] = args;
-        run(reproc_args, out);
+        return run(reproc_args, out);
     }
 
     void xcmake::xmake_configure() const
@@ -124,7 +325,7 @@ namespace xc
         values.emplace_back("config");
         std::string out;
         working_directory_ = std::string("D:\\tmp\\xtest");
-        run("xmake", { "config", "-v", "--confirm=n" }, [&out](std::string data) { out += data; });
+        run("xmake", { "config", "-v", "--confirm=n" }, [&out](std::string_view data) { out.append(data).push_back('\n'); });
         out = out.substr(14);
 
         for (auto line : std::views::split(out, "\n"))
@@ -137,45 +338,62 @@ namespace xc
         run("xmake", values, xlogger_);*/
     }
 
-    const xc::parameter& xcmake::parameter(const std::string& name) const
+    std::string xcmake::cmake_version() const
     {
-        auto parameter_it = std::find_if(parameters_.begin(), parameters_.end(), [&name](const auto& parameter) { return parameter.name == name; });
-        assert(parameter_it != parameters_.end() && "parameter not found");
-        return *parameter_it;
+        return tool_version("cmake", [](const std::string& out) {
+            using namespace std::views;
+            auto view = all(out) | drop(14) | take_while([](char c) { return c != '\n'; }) | common;
+            return std::string{ view.begin(), view.end() };
+        });
     }
 
-    std::string xcmake::parameter_value(const std::string& name, const std::string& default_value) const
+    std::string xcmake::xmake_version() const
     {
-        auto parameter_it = std::find_if(parameters_.begin(), parameters_.end(), [&name](const auto& parameter) { return parameter.name == name; });
-        if (parameter_it != parameters_.end()) return parameter_it->value;
-        else return default_value;
+        return tool_version("xmake", [](const std::string& out) {
+            using namespace std::views;
+            auto view = all(out) | drop_while([](char c) { return c != 'v'; }) | take_while([](char c) { return c != ','; }) | common;
+            return std::string{ view.begin(), view.end() };
+        });
     }
 
-    bool xcmake::has_parameter(const std::string& name, xc::parameter_type type) const
+    std::string xcmake::tool_version(const std::string& program, const std::function<std::string(const std::string&)>& parse) const
     {
-        return parameters_.end() != std::find_if(parameters_.begin(), parameters_.end(), [&name, type](const auto& parameter) {
-                   return parameter.name == name && parameter.type == type;
-               });
-    }
-    std::string xcmake::cmake_version() const
-    {
-        std::string out;
-        run("cmake", "--version", [&out](std::string data) { out += std::move(data); });
+        // probes are keyed on the binary identity so that an updated tool is probed again
+        auto identity = xc::program_identity(xc::find_program(program));
+        auto key = program + "." + xc::fingerprint{}.add(identity).str();
 
-        using namespace std::views;
-        auto view = all(out) | drop(14) | take_while([](char c) { return c != '\n'; }) | common;
+        // probes are also kept in memory for a resident daemon
+        static std::mutex memo_mutex;
+        static std::map<std::string, std::string> memo;
+        {
+            std::lock_guard lock{ memo_mutex };
+            if (auto it = memo.find(key); !identity.empty() && it != memo.end()) return it->second;
+        }
 
-        return std::string{ view.begin(), view.end() };
-    }
-    std::string xcmake::xmake_version() const
-    {
-        std::string out = *new std::string;
-        run("xmake", "--version", [&out](std::string data) { out += data; });
+        xc::cache versions{ xc::cache_directory() / "versions.cache" };
+        if (!identity.empty())
+        {
+            auto version = versions.get(key);
+            if (!version.empty())
+            {
+                std::lock_guard lock{ memo_mutex };
+                memo[key] = version;
+                return version;
+            }
+        }
 
-        using namespace std::views;
-        auto view = all(out) | drop_while([](char c) { return c != 'v'; }) | take_while([](char c) { return c != ','; }) | common;
+        std::string out;
+        run(program, "--version", [&out](std::string_view data) { out.append(data).push_back('\n'); });
+        auto version = parse(xc::clean_colors(out));
 
-        return std::string{ view.begin(), view.end() };
+        if (!identity.empty() && !version.empty())
+        {
+            versions.set(key, version);
+            versions.save();
+            std::lock_guard lock{ memo_mutex };
+            memo[key] = version;
+        }
+        return version;
     }
 
     std::string xcmake::color(const std::string& data, const std::string& color) const
@@ -184,10 +402,10 @@ namespace xc
         return "\033[" + color + "m" + data + "\033[0m";
     }
 
-    void xcmake::build()
+    int xcmake::build()
     {
         colorize_console_ = true;
-        auto build_path = parameter("build").value;
+        std::string build_path{ command_.build_directory };
         working_directory_ = build_path;
 
         // if (build_path != prev build_path) generate();
@@ -197,38 +415,331 @@ namespace xc
         else if (build_path.find("releasedbg") != std::string::npos) mode = "releasedbg";
         else mode = "release";
 
-        auto target_name = parameter_value("target", "all");
-        auto target = target_name;
-        if (target == "clean")
+        // targets dumped during generation (XC_FILE_API), they give the owning target of a source file
+        std::optional<xc::project_info> project;
+        auto project_info = [&]() -> const xc::project_info& {
+            if (!project)
+            {
+                project.emplace();
+                std::error_code ec;
+                auto project_file = build_path + "/.xc/project-info.txt";
+                if (std::filesystem::exists(project_file, ec)) project = xc::read_project_info(project_file);
+            }
+            return *project;
+        };
+
+        // every target is built by a single xmake invocation, "clean" runs before them as with cmake
+        // object files requested by the ide to compile a single file are built with xmake build --files on their owning target
+        std::vector<std::string> targets;
+        std::map<std::string, std::vector<std::string>> files;
+        bool clean = command_.clean_first;
+        bool all = command_.targets.empty();
+        for (auto target : command_.targets)
+        {
+            if (target == "clean") clean = true;
+            else if (target == "all") all = true;
+            else if (auto object = xc::parse_object_target(target))
+            {
+                auto source = xc::find_source(project_info(), object->path);
+                auto owner = object->target.empty() && source ? source->target : object->target;
+                files[std::string{ owner }].emplace_back(source ? source->path : object->path);
+            }
+            else targets.emplace_back(target);
+        }
+        if (clean)
         {
-            run("xmake", { "clean", "-P", build_path }, xlogger_);
-            return;
+            auto clean_code = run("xmake", { "clean", "-P", build_path }, xlogger_);
+            if (clean_code != 0 || (targets.empty() && files.empty() && !all)) return clean_code;
         }
-        else if (target_name == "all") target = "--all";
 
-        log("initialize build | target {} | mode {}", color(target_name, "92"), color(mode, "92"));
+        // --parallel <n> / -j <n>, then CMAKE_BUILD_PARALLEL_LEVEL like cmake, otherwise xmake default
+        unsigned jobs = command_.parallel;
+        if (jobs == 0)
+        {
+            if (const char* level = std::getenv("CMAKE_BUILD_PARALLEL_LEVEL")) jobs = static_cast<unsigned>(std::max(0, std::atoi(level)));
+        }
 
-        run("xmake", { "config", "-P", build_path, "--import=build/xmake-config-" + mode + ".txt", "-y" }, xlogger_);
+        std::string target_names = all ? "all" : "";
+        if (all) targets = { "--all" };
+        else for (const auto& target : targets) target_names += (target_names.empty() ? "" : " ") + target;
+        for (const auto& [owner, sources] : files)
+        {
+            for (const auto& source : sources) target_names += (target_names.empty() ? "" : " ") + source;
+        }
+        log("initialize build | target {} | mode {}{}", color(target_names, "92"), color(mode, "92"),
+            jobs ? " | jobs " + color(std::to_string(jobs), "92") : "");
+
+        // the import is only needed when the exported configuration changed since the last build
+        // and when the configuration of the project, shared by every build directory and mode, is still the one imported
+        xc::cache stamp{ build_path + "/.xc/build.cache" };
+        auto source_directory = stamp.get("source");
+        if (source_directory.empty())
+        {
+            // not generated by this version of xc, the project is found like xmake does
+            std::error_code ec;
+            for (auto path = std::filesystem::absolute(build_path, ec); !path.empty(); path = path.parent_path())
+            {
+                if (std::filesystem::exists(path / "xmake.lua", ec))
+                {
+                    source_directory = path.string();
+                    break;
+                }
+                if (path == path.parent_path()) break;
+            }
+        }
+        auto config_file = "build/xmake-config-" + mode + ".txt";
+        auto config_hash = source_directory.empty() ? std::string{} : xc::file_fingerprint(std::filesystem::path{ source_directory } / config_file);
+        auto config_key = [&] { return xc::fingerprint{}.add(config_hash).add(mode).add(build_path).add(xc::xmake_state_fingerprint(source_directory)).str(); };
+        if (config_hash.empty() || stamp.get("config") != config_key())
+        {
+            auto import_code = run("xmake", { "config", "-P", build_path, "--import=" + config_file, "-y" }, xlogger_);
+            if (import_code == 0 && !config_hash.empty())
+            {
+                stamp.set("config", config_key());
+                stamp.save();
+            }
+        }
+
+        // XC_TRACE=<file> writes the build jobs timeline
+        const char* trace_file = std::getenv("XC_TRACE");
+        std::optional<xc::timeline> timeline;
+        if (trace_file) timeline.emplace(jobs);
+
+        // XC_FAIL_FAST=<n> stops the build after n errors
+        const char* fail_fast = std::getenv("XC_FAIL_FAST");
+        int max_errors = fail_fast ? std::atoi(fail_fast) : 0;
+
+        // XC_PROGRESS, progress lines share a status line refreshed at most every XC_PROGRESS_INTERVAL
+        bool status_line = xc::detect_progress_mode() == xc::progress_mode::line;
+        auto status_interval = xc::progress_interval();
+        std::chrono::steady_clock::time_point status_time;
+        bool status_shown = false;
+
+        // every diagnostic is recorded in the diagnostics log read by xc --last-errors
+        // with their owning target when the xmake targets were dumped (XC_FILE_API)
+        xc::diagnostics_writer diagnostics;
+        std::map<std::string, std::string, std::less<>> file_targets;
+        auto target_of = [&](std::string_view file) -> std::string_view {
+            auto it = file_targets.find(file);
+            if (it == file_targets.end()) it = file_targets.emplace(file, xc::owning_target(project_info(), file)).first;
+            return it->second;
+        };
+
+        // xmake splits the files like the PATH variable
+#if defined(_WIN32)
+        constexpr char files_separator = ';';
+#else
+        constexpr char files_separator = ':';
+#endif
+        auto build_args = [&] {
+            std::vector<std::string> args{ "build", "-P", build_path };
+            if (jobs) args.push_back("-j" + std::to_string(jobs));
+            return args;
+        };
+        std::vector<std::vector<std::string>> invocations;
+        for (const auto& [owner, sources] : files)
+        {
+            auto args = build_args();
+            std::string option = "--files=";
+            for (std::size_t i = 0; i < sources.size(); ++i)
+            {
+                if (i) option += files_separator;
+                option += sources[i];
+            }
+            args.push_back(std::move(option));
+            if (!owner.empty()) args.push_back(owner);
+            invocations.push_back(std::move(args));
+        }
+        if (!targets.empty())
+        {
+            auto args = build_args();
+            args.insert(args.end(), targets.begin(), targets.end());
+            invocations.push_back(std::move(args));
+        }
+
+        // XC_MAX_NOTES=<n> notes printed after a diagnostic (4 by default, 0 prints everything)
+        // the full output of the build is kept in the side log
+        const char* max_notes = std::getenv("XC_MAX_NOTES");
+        xc::diagnostic_filter filter{ static_cast<std::size_t>(max_notes ? std::max(0, std::atoi(max_notes)) : 4) };
+        auto side_log_file = build_path + "/.xc/last-build.log";
+        std::error_code ec;
+        std::filesystem::create_directories(build_path + "/.xc", ec);
+        std::ofstream side_log{ side_log_file, std::ios::trunc };
+        if (!side_log.is_open()) error("unable to write {}", side_log_file);
+
+        auto print = [&](std::string_view line, const std::optional<xc::diagnostic>& diagnostic) {
+            // other lines are printed in full above the status line
+            if (status_shown)
+            {
+                xc::console::instance().write("\r\033[K");
+                status_shown = false;
+            }
+            log_xmake(line, diagnostic, false);
+        };
 
         auto time = std::chrono::system_clock::now();
-        run("xmake", { "build", "-P", build_path, target }, [this](std::string data) {
-            log_xmake(data, false);
-            if (data.find(": error") != std::string::npos) ++errors_count_;
-            if (data.find(": warning") != std::string::npos) ++warnings_count_;
-            // if (data.find(".cpp.obj")) ++warnings_count_;
-        });
+        auto on_output = [&, max_errors](std::string_view data) {
+            auto message = xc::clean_colors(data);
+            if (side_log.is_open()) side_log << message << '\n';
+            auto diagnostic = xc::parse_diagnostic(message);
+            std::optional<xc::progress> progress;
+            // "error: build failed" of xmake is printed but not counted
+            bool record = diagnostic && xc::is_compiler_record(*diagnostic);
+            if (record && diagnostic->severity >= xc::severity::error) ++errors_count_;
+            else if (record && diagnostic->severity == xc::severity::warning) ++warnings_count_;
+            else if (!diagnostic) progress = xc::parse_progress(message);
+            if (progress && timeline) timeline->add(*progress);
+            if (record) diagnostics.add(*diagnostic, target_of(diagnostic->file));
+
+            if (progress)
+            {
+                // a progress line ends the notes of the previous diagnostic
+                filter.close(print);
+                if (!status_line) print(message, diagnostic);
+                else
+                {
+                    // the skipped progress lines are not rendered at all
+                    auto now = std::chrono::steady_clock::now();
+                    if (status_shown && now - status_time < status_interval) return;
+                    status_time = now;
+                    status_shown = true;
+                    log_xmake(message, diagnostic, true);
+                }
+                return;
+            }
+            filter.add(message, diagnostic, print);
+            if (record && diagnostic->severity >= xc::severity::error && errors_count_ == max_errors)
+            {
+                log("{} errors, stop the build", max_errors);
+                xc::supervisor::instance().terminate();
+            }
+        };
+        int exit_code = 0;
+        for (const auto& args : invocations)
+        {
+            exit_code = run("xmake", args, on_output);
+            if (exit_code != 0) break;
+        }
+        filter.close(print);
+        if (status_shown) xc::console::instance().write("\r\033[K");
+        side_log.close();
+        if (filter.collapsed() && side_log.good()) log("{} repetitive lines collapsed, full output in {}", filter.collapsed(), side_log_file);
+        else if (filter.collapsed()) log("{} repetitive lines collapsed", filter.collapsed());
         log("build finished in {} {} {}",
             color(xc::to_string(std::chrono::system_clock::now() - time), "36"),
             (errors_count_ ? color("| errors " + std::to_string(errors_count_), "31") : ""),
-            (errors_count_ ? color("| warnings " + std::to_string(warnings_count_), "33") : ""));
+            (warnings_count_ ? color("| warnings " + std::to_string(warnings_count_), "33") : ""));
+
+        if (timeline)
+        {
+            timeline->finish();
+            // the build is done, an unwritable trace doesn't change its result
+            try
+            {
+                timeline->write_trace(trace_file);
+                log("build trace written to {}", trace_file);
+            }
+            catch (const std::exception& e)
+            {
+                error("{}", e.what());
+            }
+            if (!timeline->serial()) log("job durations are only measured in a serial build (--parallel 1)");
+            for (const auto* job : timeline->slowest(10))
+            {
+                auto duration = std::chrono::duration<double>(*job->end - job->start).count();
+                log("  {} {} {}", color(fmt::format("{:8.2f}s", duration), "36"), job->action, job->name);
+            }
+        }
 
         colorize_console_ = false;
+        if (exit_code == 0 && errors_count_ > 0) exit_code = 1;
+
+        // XC_DIAGNOSTICS_BUILDS=<n> number of builds kept in the log
+        const char* max_builds = std::getenv("XC_DIAGNOSTICS_BUILDS");
+        diagnostics.save(build_path + "/.xc/diagnostics.log", mode, target_names, exit_code, max_builds ? std::max(0, std::atoi(max_builds)) : 10);
+        return exit_code;
+    }
+
+    // xc --last-errors [-B <build directory>] [--severity note|warning|error] [--file <path part>] [--target <name>...]
+    // diagnostics of the last build read from the diagnostics log, xmake is not invoked
+    int xcmake::last_errors()
+    {
+        std::string build_directory{ command_.build_directory.empty() ? "." : command_.build_directory };
+        xc::diagnostics_log diagnostics{ build_directory + "/.xc/diagnostics.log" };
+        const auto& builds = diagnostics.builds();
+        if (builds.empty())
+        {
+            log("no build recorded in {}", build_directory);
+            return 1;
+        }
+
+        auto min_severity = xc::severity::error;
+        std::string_view file_filter;
+        for (const auto& option : command_.options)
+        {
+            if (option.name == "--file") file_filter = option.value;
+            else if (option.name == "--severity")
+            {
+                for (auto severity : { xc::severity::note, xc::severity::warning, xc::severity::error, xc::severity::fatal })
+                {
+                    if (xc::to_string(severity) == option.value) min_severity = severity;
+                }
+            }
+        }
+
+        auto& console = xc::console::instance();
+        for (const auto& diagnostic : builds.back().diagnostics)
+        {
+            if (diagnostic.file.empty() || diagnostic.severity < min_severity) continue;
+            if (!file_filter.empty() && diagnostic.file.find(file_filter) == std::string_view::npos) continue;
+            if (!command_.targets.empty() && std::ranges::find(command_.targets, diagnostic.target) == command_.targets.end()) continue;
+
+            // file:line:col: prefix, only the file for a tool record such as "LINK : fatal error"
+            std::string location;
+            if (!diagnostic.file.empty()) location = diagnostic.line ? fmt::format("{}:{}:{}: ", diagnostic.file, diagnostic.line, diagnostic.column) : fmt::format("{}: ", diagnostic.file);
+            console.write({ location, xc::to_string(diagnostic.severity), ": ", diagnostic.message,
+                            diagnostic.code.empty() ? "" : " [", diagnostic.code, diagnostic.code.empty() ? "" : "]",
+                            diagnostic.target.empty() ? "" : " (", diagnostic.target, diagnostic.target.empty() ? "" : ")", "\n" });
+        }
+
+        // counts of every kept build, compared to the previous one
+        int previous_errors = 0;
+        int previous_warnings = 0;
+        for (std::size_t i = 0; i < builds.size(); ++i)
+        {
+            const auto& build = builds[i];
+            int errors = 0;
+            int warnings = 0;
+            for (const auto& diagnostic : build.diagnostics)
+            {
+                // summary lines of xmake recorded by previous versions of xc
+                if (diagnostic.file.empty()) continue;
+                if (diagnostic.severity >= xc::severity::error) ++errors;
+                else if (diagnostic.severity == xc::severity::warning) ++warnings;
+            }
+
+            char date[32]{};
+            auto time = static_cast<std::time_t>(build.time);
+            std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+            log("build {} | {} | target {} | mode {} | exit {} | errors {}{} | warnings {}{}", i + 1, date, build.targets, build.mode, build.exit_code, errors,
+                i ? fmt::format(" ({:+})", errors - previous_errors) : "", warnings, i ? fmt::format(" ({:+})", warnings - previous_warnings) : "");
+            previous_errors = errors;
+            previous_warnings = warnings;
+        }
+        return 0;
+    }
+
+    int xcmake::pregenerate()
+    {
+        pregenerate_ = true;
+        phase_ = "pregenerate";
+        return generate();
     }
 
-    void xcmake::generate()
+    int xcmake::generate()
     {
-        std::string source_directory = parameter_value("S", ".");
-        std::string build_directory = parameter_value("B", ".");
+        std::string source_directory{ command_.source_directory.empty() ? "." : command_.source_directory };
+        std::string build_directory{ command_.build_directory.empty() ? "." : command_.build_directory };
         log("source directory: {}", source_directory);
         log("build directory: {}", build_directory);
         working_directory_ = source_directory;
@@ -238,71 +749,336 @@ namespace xc
             run("xmake", { "config", "-c", "-y" });
         }
 
-        auto mode = xc::xmake_value[parameter_value("CMAKE_BUILD_TYPE", "Release")];
+        std::string build_type{ command_.build_type.empty() ? "Release" : command_.build_type };
+        auto mode = xc::xmake_value[build_type];
+        profile current{ build_directory, args_, mode, source_directory + "/build/xmake-config-" + mode + ".txt" };
+        auto cmakelists_file = source_directory + "/CMakeLists.txt";
 
-        log("input configuration | mode {}", mode);
-        log("save xmake configuration to {}", source_directory + "/build/xmake-config-" + mode + ".txt");
-        std::vector<std::string> xmake_config;
-        xmake_config.emplace_back("config");
-        xmake_config.emplace_back("-m");
-        xmake_config.emplace_back(mode);
-        xmake_config.emplace_back("--export=" + source_directory + "/build/xmake-config-" + mode + ".txt");
-        xmake_config.emplace_back("--confirm=n");
+        // a generation of the watcher and one of the ide don't run concurrently
+        std::filesystem::create_directories(build_directory + "/.xc");
+        xc::file_lock generate_lock{ build_directory + "/.xc/generate.lock" };
+
+        // arguments are read back by the generation of sibling profiles and by the watcher
+        {
+            std::ofstream ofs{ build_directory + "/.xc/arguments.txt", std::ios::trunc };
+            for (const auto& arg : args_) ofs << arg << '\n';
+        }
+        if (!pregenerate_) xc::watch::update(program_, build_directory, xc::is_on(command_.value("XC_WATCH")));
+        {
+            // the build finds the exported configurations in the source directory
+            std::error_code ec;
+            xc::cache stamp{ build_directory + "/.xc/build.cache" };
+            stamp.set("source", std::filesystem::absolute(source_directory, ec).lexically_normal().string());
+            stamp.save();
+        }
+
+        xc::cache cache{ build_directory + "/.xc/generate.cache" };
+        if (xc::is_on(command_.value("XC_REGENERATE")))
+        {
+            log("generation cache invalidated");
+            cache.clear();
+        }
+
+        auto lua_hash = xc::lua_fingerprint(source_directory, build_directory);
+        auto xmake_version_value = xmake_version();
+
+        auto configure_key = [&](const profile& profile) {
+            auto command = xc::parse_command(profile.args);
+            xc::fingerprint hash;
+            hash.add(lua_hash).add(profile.mode).add(xmake_version_value).add(command.source_directory).add(command.generator);
+            for (const auto& entry : command.entries | std::views::filter([](const auto& e) { return e.kind != xc::parameter_type::user_xc; }))
+            {
+                hash.add(entry.name).add(entry.value).add(std::to_string(static_cast<int>(entry.kind)));
+            }
+            for (const auto& option : command.options) hash.add(option.name).add(option.value);
+            return hash.str();
+        };
+        auto project_key = [&](const profile& profile) {
+            return xc::fingerprint{}.add(lua_hash).add(xc::file_fingerprint(profile.config_file)).add(xmake_version_value).str();
+        };
+
+        // cmakelists are generated from the current xmake state, both stages are skipped together
+        bool configure_fresh = cache.get("configure") == configure_key(current) && !cache.get("configure.output").empty()
+                            && cache.get("configure.output") == xc::file_fingerprint(current.config_file);
+        bool project_fresh = configure_fresh && cache.get("project") == project_key(current) && !cache.get("project.output").empty()
+                          && cache.get("project.output") == xc::file_fingerprint(cmakelists_file);
+
+        if (project_fresh) log("xmake configuration unchanged, skip configure and cmakelists generation");
+        else
+        {
+            // other profiles are exported concurrently in isolated xmake states, the cmakelists are generated once
+            auto profiles = sibling_profiles(source_directory, build_directory);
+            for (auto build_type : std::views::split(command_.value("XC_BUILD_TYPES"), ';'))
+            {
+                auto other_mode = xc::xmake_value[std::string{ build_type.begin(), build_type.end() }];
+                if (other_mode.empty() || other_mode == mode) continue;
+                if (std::ranges::any_of(profiles, [&other_mode](const auto& p) { return p.mode == other_mode; })) continue;
+                profiles.push_back(profile{ {}, args_, other_mode, source_directory + "/build/xmake-config-" + other_mode + ".txt" });
+            }
+            std::erase_if(profiles, [&mode](const auto& p) { return p.mode == mode; });
+
+            // the threads are joined before the codes are released, also when the current configuration throws
+            std::vector<int> export_codes(profiles.size());
+            std::vector<std::jthread> exports;
+            for (std::size_t i = 0; i < profiles.size(); ++i)
+            {
+                log("save xmake configuration to {}", profiles[i].config_file);
+                exports.emplace_back([this, &other = profiles[i], &exit_code = export_codes[i], &build_directory] {
+                    try
+                    {
+                        exit_code = run("xmake", xmake_config_args(other), { { "XMAKE_CONFIGDIR", build_directory + "/.xc/xmake-" + other.mode } }, xlogger_);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        error("xmake configuration of mode {} failed : {}", other.mode, e.what());
+                        exit_code = 1;
+                    }
+                });
+            }
+
+            log("input configuration | mode {}", mode);
+            log("save xmake configuration to {}", current.config_file);
+            for (const auto& entry : command_.entries | std::views::filter([](const auto& e) { return e.kind == xc::parameter_type::user; }))
+            {
+                log("-- {} : {}", entry.name, entry.value);
+            }
+            for (const auto& mapping : xc::map_cmake_entries(command_))
+            {
+                if (mapping.option.empty()) log("-- {} : {} not supported, {}", mapping.entry, mapping.value, mapping.note);
+                else log("-- {} : {} mapped to --{}={}", mapping.entry, mapping.value, mapping.option, mapping.option_value);
+            }
+            log("configure");
+            auto configure_code = run("xmake", xmake_config_args(current), xlogger_);
+            for (auto& thread : exports) thread.join();
+            if (configure_code != 0)
+            {
+                error("xmake configuration failed");
+                return configure_code;
+            }
+
+            // the cmakelists are generated in place, their paths are relative to the source directory
+            // an identical content is restored with its previous time so that cmake and the ide don't reload the project
+            log("generate cmakelists");
+            std::error_code ec;
+            auto previous_cmakelists = xc::read_file(cmakelists_file);
+            auto previous_time = std::filesystem::last_write_time(cmakelists_file, ec);
+            if (auto project_code = run("xmake", { "project", "-k", "cmake" }, xlogger_); project_code != 0)
+            {
+                error("cmakelists generation failed");
+                return project_code;
+            }
+            if (!ec && !previous_cmakelists.empty() && xc::cmake_content(previous_cmakelists) == xc::cmake_content(xc::read_file(cmakelists_file)))
+            {
+                log("cmakelists unchanged");
+                xc::write_file(cmakelists_file, previous_cmakelists);
+                std::filesystem::last_write_time(cmakelists_file, previous_time, ec);
+            }
+            auto cmakelists_hash = xc::file_fingerprint(cmakelists_file);
+
+            cache.set("configure", configure_key(current));
+            cache.set("configure.output", xc::file_fingerprint(current.config_file));
+            cache.set("project", project_key(current));
+            cache.set("project.output", cmakelists_hash);
+            cache.save();
+
+            // the next generation of a sibling profile finds its stages done
+            for (std::size_t i = 0; i < profiles.size(); ++i)
+            {
+                const auto& other = profiles[i];
+                if (other.build_directory.empty() || export_codes[i] != 0) continue;
+                xc::cache other_cache{ other.build_directory + "/.xc/generate.cache" };
+                other_cache.set("configure", configure_key(other));
+                other_cache.set("configure.output", xc::file_fingerprint(other.config_file));
+                other_cache.set("project", project_key(other));
+                other_cache.set("project.output", cmakelists_hash);
+                other_cache.save();
+            }
+        }
+
+        // targets of the current xmake configuration, used to answer the cmake file api
+        bool file_api = xc::is_on(command_.value("XC_FILE_API"));
+        auto project_info_file = build_directory + "/.xc/project-info.txt";
+        if (file_api && (!project_fresh || !std::filesystem::exists(project_info_file)))
+        {
+            log("dump xmake targets");
+            auto script_file = build_directory + "/.xc/project-info.lua";
+            xc::write_file(script_file, xc::project_script);
+            std::error_code ec;
+            std::filesystem::remove(project_info_file, ec);
+            run("xmake", { "lua", std::filesystem::absolute(script_file).string(), std::filesystem::absolute(project_info_file).string() }, xlogger_);
+        }
+
+        // the watcher only prepares the xmake stages, cmake runs when the ide asks
+        if (pregenerate_) return 0;
 
-        for (const auto& parameter : parameters_)
+        xc::fingerprint toolchain_hash;
+        toolchain_hash.add(cmake_version());
+        for (const auto& arg : args_ | std::views::filter([](const auto& arg) { return !arg.starts_with("-DXC_"); })) toolchain_hash.add(arg);
+
+        // the reply of the last cmake run with the same arguments provides the cache and toolchains objects
+        if (file_api && cache.get("cmake.toolchain") == toolchain_hash.str() && std::filesystem::exists(build_directory + "/CMakeCache.txt")
+            && std::filesystem::exists(project_info_file))
         {
-            if (parameter.type == xc::parameter_type::user)
+            auto reply_key = xc::fingerprint{}.add(toolchain_hash.str()).add(xc::file_fingerprint(project_info_file)).str();
+            if (cache.get("file_api") == reply_key && std::filesystem::exists(build_directory + "/.cmake/api/v1/reply"))
             {
-                log("-- {}", parameter.name + " : " + parameter.value);
-                xmake_config.emplace_back("--" + parameter.name + "=" + parameter.value);
+                log("xmake targets unchanged, skip cmake file api reply");
+                return 0;
             }
-            else if (parameter.type == xc::parameter_type::user_cmake)
+            if (xc::write_file_api_reply(source_directory, build_directory, build_type, xc::read_project_info(project_info_file)))
             {
-                // if (has_parameter("CMAKE_BUILD_TYPE")) xmake_config.emplace_back("-m " + xc::xmake_value[parameter.value]);
+                log("cmake file api reply written from xmake targets, skip forward cmake initialization");
+                cache.set("file_api", reply_key);
+                cache.save();
+                return 0;
             }
         }
-        log("configure");
-        run("xmake", xmake_config, xlogger_);
 
-        log("generate cmakelists");
-        run("xmake", { "project", "-k", "cmake" }, xlogger_);
+        xc::fingerprint cmake_hash;
+        cmake_hash.add(xc::file_fingerprint(cmakelists_file)).add(cmake_version());
+        for (const auto& arg : args_) cmake_hash.add(arg);
+
+        if (cache.get("cmake") == cmake_hash.str() && std::filesystem::exists(build_directory + "/CMakeCache.txt")
+            && std::filesystem::exists(build_directory + "/.cmake/api/v1/reply"))
+        {
+            log("cmake inputs unchanged, skip forward cmake initialization");
+            return 0;
+        }
 
-        auto clog = [this](std::string data) {
-            if (data == "-- Generating done\n") log("cmake generation succeed");
+        bool generated = false;
+        auto clog = [this, &generated](std::string_view data) {
+            if (data == "-- Generating done")
+            {
+                generated = true;
+                log("cmake generation succeed");
+            }
         };
 
         log("forward cmake initialization");
-        decltype(args_) args;
-        for (auto& item : args_) args.emplace_back("\"" + item + "\"");
-        run("cmake", args, clog);
+        auto args = cmake_args();
+        auto exit_code = run("cmake", args, clog);
+
+        cache.set("cmake", generated ? cmake_hash.str() : "");
+        cache.set("cmake.toolchain", generated ? toolchain_hash.str() : "");
+        cache.set("file_api", "");
+        cache.save();
+        return exit_code;
+    }
+
+    std::vector<std::string> xcmake::cmake_args() const
+    {
+        // the arguments are joined in a command line on windows only
+#if defined(_WIN32)
+        std::vector<std::string> args;
+        for (const auto& arg : args_) args.emplace_back("\"" + arg + "\"");
+        return args;
+#else
+        return args_;
+#endif
     }
 
-    void xcmake::log_cmake(std::string message) const
+    std::vector<std::string> xcmake::xmake_config_args(const profile& profile) const
+    {
+        std::vector<std::string> xmake_config;
+        xmake_config.emplace_back("config");
+        xmake_config.emplace_back("-m");
+        xmake_config.emplace_back(profile.mode);
+        xmake_config.emplace_back("--export=" + profile.config_file);
+        xmake_config.emplace_back("--confirm=n");
+
+        auto command = xc::parse_command(profile.args);
+        // xmake takes a single list of policies, the ones of the cmake entries are merged with -Dpolicies
+        std::string policies;
+        auto add_policies = [&policies](std::string_view value) { policies += (policies.empty() ? "" : ",") + std::string{ value }; };
+        for (const auto& entry : command.entries)
+        {
+            if (entry.kind != xc::parameter_type::user) continue;
+            if (entry.name == "policies") add_policies(entry.value);
+            else xmake_config.emplace_back(fmt::format("--{}={}", entry.name, entry.value));
+        }
+        for (const auto& mapping : xc::map_cmake_entries(command))
+        {
+            if (mapping.option == "policies") add_policies(mapping.option_value);
+            else if (!mapping.option.empty())
+            {
+                // the c and c++ launchers map to the same option
+                auto option = fmt::format("--{}={}", mapping.option, mapping.option_value);
+                if (std::ranges::find(xmake_config, option) == xmake_config.end()) xmake_config.push_back(std::move(option));
+            }
+        }
+        if (!policies.empty()) xmake_config.emplace_back("--policies=" + policies);
+        return xmake_config;
+    }
+
+    // profiles of the same project generated by xc in the directories next to the build directory
+    std::vector<xcmake::profile> xcmake::sibling_profiles(const std::string& source_directory, const std::string& build_directory) const
+    {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+
+        auto source = fs::weakly_canonical(source_directory, ec);
+        auto build = fs::weakly_canonical(build_directory, ec);
+        std::vector<profile> profiles;
+
+        for (const auto& entry : fs::directory_iterator{ build.parent_path(), ec })
+        {
+            std::ifstream ifs{ entry.path() / ".xc" / "arguments.txt" };
+            if (!ifs || fs::equivalent(entry.path(), build, ec)) continue;
+
+            std::vector<std::string> args;
+            std::string arg;
+            while (std::getline(ifs, arg)) args.emplace_back(std::move(arg));
+
+            try
+            {
+                auto command = xc::parse_command(args);
+                if (fs::weakly_canonical(command.source_directory.empty() ? "." : command.source_directory, ec) != source) continue;
+
+                auto mode = xc::xmake_value[std::string{ command.build_type.empty() ? "Release" : command.build_type }];
+                if (std::ranges::any_of(profiles, [&mode](const auto& p) { return p.mode == mode; })) continue;
+                profiles.push_back(profile{ entry.path().string(), std::move(args), mode, source_directory + "/build/xmake-config-" + mode + ".txt" });
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+        }
+        return profiles;
+    }
+
+    void xcmake::log_cmake(std::string_view message) const
     {
-        if (message.back() == '\n') message.resize(message.size() - 1);
         if (message.empty()) return;
-        std::cout << ("[xc:" + color("cmake", "33") + "] ") << message << std::endl;
+        xc::console::instance().write({ "[xc:", color("cmake", "33"), "] ", message, "\n" });
     }
 
     // todo use colorize function, only for build commands
-    void xcmake::log_xmake(std::string message, bool single_line) const
+    void xcmake::log_xmake(std::string_view data, bool single_line) const
     {
-        if (message.back() == '\n') message.resize(message.size() - 2);
-        if (message.empty() || message == "\n") return;
-        if (message.find("> in") != std::string::npos) return;
-        message = clean_colors(message);
-
-        std::string type = " ";
-        if (message.find(".hpp(") != std::string::npos) type = color(" ", "32;42");
-        else if (message.find(".tpp(") != std::string::npos) type = color(" ", "32;42");
-        else if (message.find(".cpp(") != std::string::npos) type = color(" ", "94;44");
+        if (data.empty()) return;
+        auto message = clean_colors(data);
+        log_xmake(message, xc::parse_diagnostic(message), single_line);
+    }
 
-        if (message.find(": error") != std::string::npos) str_replace(message, ": error", color(" error", "91;1"));
-        else if (message.find(": note") != std::string::npos) str_replace(message, ": note", color(" note", "37;1"));
+    void xcmake::log_xmake(std::string_view message, const std::optional<xc::diagnostic>& diagnostic, bool single_line) const
+    {
+        if (message.empty()) return;
+        if (!diagnostic && message.find("> in") != std::string::npos) return;
 
-        if (message.find(R"(Community\VC\Tools\MSVC)") != std::string::npos)
+        std::string type = " ";
+        std::string_view label;
+        std::string highlight;
+        if (diagnostic)
         {
-            type = color(" ", "33;43");
+            const auto& file = diagnostic->file;
+            if (file.ends_with(".hpp") || file.ends_with(".h") || file.ends_with(".tpp")) type = color(" ", "32;42");
+            else if (file.ends_with(".cpp") || file.ends_with(".cc") || file.ends_with(".cxx")) type = color(" ", "94;44");
+            if (file.find(R"(VC\Tools\MSVC)") != std::string_view::npos) type = color(" ", "33;43");
+
+            label = diagnostic->label;
+            if (diagnostic->severity >= xc::severity::error) highlight = color(" " + std::string{ xc::to_string(diagnostic->severity) }, "91;1");
+            else if (diagnostic->severity == xc::severity::note) highlight = color(" note", "37;1");
+            else label = {};
         }
 
         /*
@@ -312,9 +1088,9 @@ namespace xc
         str_replace(message, "public:", "\033[38;2;240;126;29;1mpublic: \033[0m");
         str_replace(message, "virtual", "\033[38;2;240;126;29;1m virtual \033[0m");*/
 
-        if (single_line) std::cout << "\r";
-        std::cout << ("[xc:" + color("xmake", "96") + "] ") << type << " " << message;
-        if (single_line) std::cout << std::flush;
-        else std::cout << std::endl;
+        auto prefix = label.empty() ? message : message.substr(0, label.data() - message.data());
+        auto suffix = label.empty() ? std::string_view{} : message.substr(prefix.size() + label.size());
+        xc::console::instance().write(
+            { single_line ? "\r" : "", "[xc:", color("xmake", "96"), "] ", type, " ", prefix, highlight, suffix, single_line ? "\033[K" : "\n" });
     }
 } // xc
\ No newline at end of file
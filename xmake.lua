@@ -7,3 +7,34 @@ target("xc")
     add_files("source/**.cpp")
     add_includedirs("include")
     add_packages("fmt", "tiny-process-library")
+
+-- benchmarks : xmake build xc-bench && xmake run xc-bench [output.json]
+target("xc-bench")
+    set_kind("binary")
+    set_default(false)
+    set_rundir("$(projectdir)")
+    add_deps("xc-stub")
+    add_files("bench/*.cpp", "source/xc/**.cpp")
+    add_includedirs("include")
+    add_packages("fmt", "tiny-process-library")
+
+-- stand-in for xmake and cmake used by xc-bench
+target("xc-stub")
+    set_kind("binary")
+    set_default(false)
+    add_files("bench/stub/*.cpp")
+
+-- randomized test of the command line parser : xmake build xc-fuzz && xmake run xc-fuzz [iterations] [seed]
+target("xc-fuzz")
+    set_kind("binary")
+    set_default(false)
+    add_files("bench/fuzz/*.cpp", "bench/allocations.cpp", "source/xc/command.cpp")
+    add_includedirs("include")
+
+-- correctness of the build output parsing : xmake build xc-check && xmake run xc-check [seed]
+target("xc-check")
+    set_kind("binary")
+    set_default(false)
+    set_rundir("$(projectdir)")
+    add_files("bench/check/*.cpp", "source/xc/diagnostic.cpp")
+    add_includedirs("include")